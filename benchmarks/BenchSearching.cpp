@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LearnedIndex.h"
+#include "Searching.h"
+#include "StaticSearchIndex.h"
+
+// Lookup latency of the searches over sorted arrays from cache-resident to
+// far larger than the last-level cache
+
+using Searcher =
+    std::function<size_t(const std::vector<uint64_t> &, uint64_t)>;
+
+// every measurement stores its results here, so the compiler cannot drop the
+// searches that produce them
+volatile size_t sink = 0;
+
+std::vector<uint64_t> makeKeys(size_t size) {
+  std::mt19937_64 generator(2024);
+  std::vector<uint64_t> keys(size);
+  for (uint64_t &key : keys) {
+    key = generator();
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+double measure(const Searcher &searcher, const std::vector<uint64_t> &keys,
+               const std::vector<uint64_t> &probes) {
+  size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t probe : probes) {
+    checksum += searcher(keys, probe);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  sink = checksum;
+  return elapsed.count() / static_cast<double>(probes.size());
+}
+
+// Searches for the key at a given position, so the position can also seed
+// a hint
+using PositionSearcher =
+    std::function<std::optional<size_t>(const std::vector<uint64_t> &, size_t)>;
+
+// Log-uniform keys, the continuous form of Zipf's law: small keys repeat
+// often and the gaps grow geometrically
+std::vector<uint64_t> makeZipfianKeys(size_t size) {
+  std::mt19937_64 generator(2024);
+  std::uniform_real_distribution<double> exponent(0.0, 40.0);
+  std::vector<uint64_t> keys(size);
+  for (uint64_t &key : keys) {
+    key = static_cast<uint64_t>(std::exp2(exponent(generator)));
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+// Dense runs of keys around a few far-apart centres
+std::vector<uint64_t> makeClusteredKeys(size_t size) {
+  std::mt19937_64 generator(2024);
+  std::vector<uint64_t> centres(64);
+  for (uint64_t &centre : centres) {
+    centre = generator() >> 2;
+  }
+  std::vector<uint64_t> keys(size);
+  for (uint64_t &key : keys) {
+    key = centres[generator() % centres.size()] + generator() % (1 << 24);
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+double measurePositions(const PositionSearcher &searcher,
+                        const std::vector<uint64_t> &keys,
+                        const std::vector<size_t> &positions) {
+  size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t position : positions) {
+    checksum += searcher(keys, position).value_or(0);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  sink = checksum;
+  return elapsed.count() / static_cast<double>(positions.size());
+}
+
+// batchLowerBound answers all probes in one call
+double measureBatch(const std::vector<uint64_t> &keys,
+                    const std::vector<uint64_t> &probes) {
+  std::vector<size_t> positions(probes.size());
+  auto start = std::chrono::steady_clock::now();
+  batchLowerBound(keys, probes, positions.begin());
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  sink = std::accumulate(positions.begin(), positions.end(), size_t{0});
+  return elapsed.count() / static_cast<double>(probes.size());
+}
+
+int main() {
+  const size_t probeCount = 1 << 20;
+  std::cout << "ns per lookup of a random key\n";
+  for (size_t size : {size_t(1) << 12, size_t(1) << 20, size_t(1) << 25}) {
+    std::vector<uint64_t> keys = makeKeys(size);
+    StaticSearchIndex<uint64_t> eytzinger(keys, IndexLayout::EYTZINGER);
+    StaticSearchIndex<uint64_t> sTree(keys, IndexLayout::S_TREE);
+    LearnedIndex learned(keys);
+    std::vector<std::pair<std::string, Searcher>> searchers = {
+        {"std::lower_bound",
+         [](const std::vector<uint64_t> &keys, uint64_t probe) {
+           return static_cast<size_t>(
+               std::lower_bound(keys.begin(), keys.end(), probe) -
+               keys.begin());
+         }},
+        {"binarySearch",
+         [](const std::vector<uint64_t> &keys, uint64_t probe) {
+           return binarySearch(keys, probe, 0, keys.size() - 1).value_or(0);
+         }},
+        {"lowerBound",
+         [](const std::vector<uint64_t> &keys, uint64_t probe) {
+           return static_cast<size_t>(lowerBound(keys, probe) - keys.begin());
+         }},
+        {"StaticSearchIndex eytzinger",
+         [&eytzinger](const std::vector<uint64_t> & /*keys*/, uint64_t probe) {
+           return eytzinger.lowerBound(probe);
+         }},
+        {"StaticSearchIndex s-tree",
+         [&sTree](const std::vector<uint64_t> & /*keys*/, uint64_t probe) {
+           return sTree.lowerBound(probe);
+         }},
+        {"LearnedIndex",
+         [&learned](const std::vector<uint64_t> & /*keys*/, uint64_t probe) {
+           return learned.lowerBound(probe);
+         }},
+    };
+
+    std::mt19937_64 generator(7);
+    std::vector<uint64_t> probes(probeCount);
+    for (uint64_t &probe : probes) {
+      // half of the probes hit a key
+      probe = generator() % 2 == 0 ? keys[generator() % size] : generator();
+    }
+    std::cout << size << " keys, learned model " << learned.getModelSize()
+              << " bytes, max error " << learned.getMaxError() << "\n";
+    for (const auto &[searcherName, searcher] : searchers) {
+      // the first pass warms the caches and the branch predictor
+      measure(searcher, keys, probes);
+      std::cout << "  " << searcherName << " "
+                << measure(searcher, keys, probes) << "\n";
+    }
+    measureBatch(keys, probes);
+    std::cout << "  batchLowerBound " << measureBatch(keys, probes) << "\n";
+    std::vector<uint64_t> sortedProbes = probes;
+    std::sort(sortedProbes.begin(), sortedProbes.end());
+    std::cout << "  batchLowerBound, sorted probes "
+              << measureBatch(keys, sortedProbes) << "\n";
+  }
+
+  std::vector<std::pair<std::string, PositionSearcher>> positionSearchers = {
+      {"binarySearch",
+       [](const std::vector<uint64_t> &keys, size_t position) {
+         return binarySearch(keys, keys[position], 0, keys.size() - 1);
+       }},
+      {"jumpSearch",
+       [](const std::vector<uint64_t> &keys, size_t position) {
+         return jumpSearch(keys, keys[position]);
+       }},
+      {"exponentialSearch",
+       [](const std::vector<uint64_t> &keys, size_t position) {
+         return exponentialSearch(keys, keys[position]);
+       }},
+      {"exponentialSearch, hint within 64",
+       [](const std::vector<uint64_t> &keys, size_t position) {
+         return exponentialSearch(keys, keys[position], position ^ 37);
+       }},
+      {"interpolationSearch",
+       [](const std::vector<uint64_t> &keys, size_t position) {
+         return interpolationSearch(keys, keys[position]);
+       }},
+  };
+  const size_t distributionSize = 1 << 25;
+  std::vector<std::pair<std::string, std::vector<uint64_t>>> distributions = {
+      {"uniform", makeKeys(distributionSize)},
+      {"zipfian", makeZipfianKeys(distributionSize)},
+      {"clustered", makeClusteredKeys(distributionSize)},
+  };
+  std::mt19937_64 generator(7);
+  std::vector<size_t> positions(1 << 16);
+  for (size_t &position : positions) {
+    position = generator() % distributionSize;
+  }
+  std::cout << "\nns per lookup of a present key among " << distributionSize
+            << " keys\n";
+  for (const auto &[distributionName, keys] : distributions) {
+    std::cout << distributionName << "\n";
+    for (const auto &[searcherName, searcher] : positionSearchers) {
+      measurePositions(searcher, keys, positions);
+      std::cout << "  " << searcherName << " "
+                << measurePositions(searcher, keys, positions) << "\n";
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RadixSort.h"
+#include "Sorting.h"
+#include "TimSort.h"
+
+// Compares the sorting routines against std::sort on typical input shapes
+
+using Sorter = std::function<void(std::vector<int64_t> &)>;
+
+std::vector<std::pair<std::string, std::vector<int64_t>>> makeInputs(
+    size_t size) {
+  std::mt19937_64 generator(2024);
+  std::vector<int64_t> random(size);
+  std::vector<int64_t> sorted(size);
+  std::vector<int64_t> organPipe(size);
+  std::vector<int64_t> fewUnique(size);
+  for (size_t i = 0; i < size; i++) {
+    random[i] = static_cast<int64_t>(generator());
+    fewUnique[i] = static_cast<int64_t>(generator() % 16);
+    sorted[i] = static_cast<int64_t>(i);
+    organPipe[i] = static_cast<int64_t>(std::min(i, size - i));
+  }
+  std::vector<int64_t> reversed(sorted.rbegin(), sorted.rend());
+  // sorted batches appended one after another
+  std::vector<int64_t> batches = random;
+  for (size_t begin = 0; begin < size; begin += size / 16) {
+    std::sort(batches.begin() + begin,
+              batches.begin() + std::min(begin + size / 16, size));
+  }
+  return {{"sorted", sorted},
+          {"reversed", reversed},
+          {"organ-pipe", organPipe},
+          {"sorted batches", batches},
+          {"random", random},
+          {"few-unique", fewUnique}};
+}
+
+double measure(const Sorter &sorter, const std::vector<int64_t> &input,
+               int repetitions) {
+  double total = 0;
+  for (int i = 0; i < repetitions; i++) {
+    std::vector<int64_t> copy = input;
+    auto start = std::chrono::steady_clock::now();
+    sorter(copy);
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    total += elapsed.count();
+    if (!std::is_sorted(copy.begin(), copy.end())) {
+      std::cerr << "output is not sorted\n";
+      std::exit(1);
+    }
+  }
+  return total / repetitions;
+}
+
+int main() {
+  const size_t size = 1 << 21;
+  const int repetitions = 5;
+  std::vector<std::pair<std::string, Sorter>> sorters = {
+      {"std::sort",
+       [](std::vector<int64_t> &array) {
+         std::sort(array.begin(), array.end());
+       }},
+      {"introSort",
+       [](std::vector<int64_t> &array) {
+         introSort(array.begin(), array.end());
+       }},
+      {"quickSort hoare",
+       [](std::vector<int64_t> &array) {
+         quickSort(array.begin(), array.end(), PartitionStrategy::HOARE);
+       }},
+      {"quickSort lomuto",
+       [](std::vector<int64_t> &array) {
+         quickSort(array.begin(), array.end(), PartitionStrategy::LOMUTO);
+       }},
+      {"quickSort block",
+       [](std::vector<int64_t> &array) {
+         quickSort(array.begin(), array.end(), PartitionStrategy::BLOCK);
+       }},
+      {"quickSort block, scalar base case",
+       [](std::vector<int64_t> &array) {
+         // a comparator other than std::less keeps the sorting networks out
+         quickSort(array.begin(), array.end(), PartitionStrategy::BLOCK,
+                   [](int64_t left, int64_t right) { return left < right; });
+       }},
+      {"std::stable_sort",
+       [](std::vector<int64_t> &array) {
+         std::stable_sort(array.begin(), array.end());
+       }},
+      {"mergeSort",
+       [](std::vector<int64_t> &array) {
+         mergeSort(array.begin(), array.end());
+       }},
+      {"timSort",
+       [](std::vector<int64_t> &array) {
+         timSort(array.begin(), array.end());
+       }},
+      {"parallelMergeSort",
+       [](std::vector<int64_t> &array) {
+         parallelMergeSort(array.begin(), array.end());
+       }},
+      {"parallelSampleSort",
+       [](std::vector<int64_t> &array) {
+         parallelSampleSort(array.begin(), array.end());
+       }},
+      {"radixSort",
+       [](std::vector<int64_t> &array) {
+         radixSort(array.begin(), array.end());
+       }},
+  };
+
+  std::cout << size << " int64_t elements (ms per sort)\n";
+  for (const auto &[inputName, input] : makeInputs(size)) {
+    std::cout << inputName << "\n";
+    for (const auto &[sorterName, sorter] : sorters) {
+      std::cout << "  " << sorterName << " "
+                << measure(sorter, input, repetitions) << "\n";
+    }
+  }
+
+  // only the 100 smallest keys have to come out sorted
+  const std::vector<std::pair<std::string, Sorter>> selectors = {
+      {"quickSort block",
+       [](std::vector<int64_t> &array) {
+         quickSort(array.begin(), array.end(), PartitionStrategy::BLOCK);
+       }},
+      {"partialSort",
+       [](std::vector<int64_t> &array) {
+         partialSort(array.begin(), array.begin() + 100, array.end());
+       }},
+      {"nthElement + quickSort",
+       [](std::vector<int64_t> &array) {
+         nthElement(array.begin(), array.begin() + 100, array.end());
+         quickSort(array.begin(), array.begin() + 100);
+       }},
+      {"topK",
+       [](std::vector<int64_t> &array) {
+         std::vector<int64_t> top = topK(array, 100);
+         std::copy(top.begin(), top.end(), array.begin());
+       }},
+  };
+  std::vector<int64_t> random;
+  for (const auto &[inputName, input] : makeInputs(size)) {
+    if (inputName == "random") {
+      random = input;
+    }
+  }
+  std::cout << "smallest 100 of random\n";
+  for (const auto &[selectorName, selector] : selectors) {
+    double total = 0;
+    for (int i = 0; i < repetitions; i++) {
+      std::vector<int64_t> copy = random;
+      auto start = std::chrono::steady_clock::now();
+      selector(copy);
+      std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - start;
+      total += elapsed.count();
+      if (!std::is_sorted(copy.begin(), copy.begin() + 100)) {
+        std::cerr << "prefix is not sorted\n";
+        return 1;
+      }
+    }
+    std::cout << "  " << selectorName << " " << total / repetitions << "\n";
+  }
+  return 0;
+}
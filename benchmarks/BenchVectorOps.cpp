@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "VectorOps.h"
+
+// Compares the dispatched kernels against plain element-by-element loops
+
+template <typename Function>
+double measure(Function function, int repetitions) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; i++) {
+    function();
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+
+std::string levelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::SCALAR:
+      return "scalar";
+    case SimdLevel::SSE42:
+      return "sse4.2";
+    case SimdLevel::AVX2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+template <typename T>
+void benchmark(const std::string &typeName, size_t size, int repetitions) {
+  Vector<T> vector(size);
+  Vector<T> other(size);
+  for (size_t i = 0; i < size; i++) {
+    vector.pushBack(static_cast<T>(i % 97));
+    other.pushBack(static_cast<T>(i % 31));
+  }
+  // keeps the compiler from dropping the loops whose results are unused
+  volatile T sink = 0;
+
+  std::cout << typeName << ", " << size << " elements (us per call)\n";
+  std::cout << "  loop    sum " << measure([&] {
+    T total = 0;
+    for (size_t i = 0; i < vector.getSize(); i++) {
+      total += vector[i];
+    }
+    sink = total;
+  }, repetitions) << "  count " << measure([&] {
+    size_t matches = 0;
+    for (size_t i = 0; i < vector.getSize(); i++) {
+      matches += vector[i] == static_cast<T>(42);
+    }
+    sink = static_cast<T>(matches);
+  }, repetitions) << "  add " << measure([&] {
+    for (size_t i = 0; i < vector.getSize(); i++) {
+      vector[i] += other[i];
+    }
+  }, repetitions) << "\n";
+
+  SimdLevel original = VectorOps<T>::getLevel();
+  for (SimdLevel level :
+       {SimdLevel::SCALAR, SimdLevel::SSE42, SimdLevel::AVX2}) {
+    if (VectorOps<T>::setLevel(level) != level) {
+      continue;
+    }
+    std::cout << "  " << levelName(level) << "  sum "
+              << measure([&] { sink = sum(vector); }, repetitions)
+              << "  count "
+              << measure([&] {
+                   sink = static_cast<T>(count(vector, static_cast<T>(42)));
+                 }, repetitions)
+              << "  add " << measure([&] { add(vector, other); }, repetitions)
+              << "\n";
+  }
+  VectorOps<T>::setLevel(original);
+}
+
+int main() {
+  const size_t size = 1 << 20;
+  const int repetitions = 50;
+  benchmark<int32_t>("int32_t", size, repetitions);
+  benchmark<int64_t>("int64_t", size, repetitions);
+  benchmark<float>("float", size, repetitions);
+  benchmark<double>("double", size, repetitions);
+  return 0;
+}
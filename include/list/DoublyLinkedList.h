@@ -3,23 +3,36 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <memory>
 #include <ostream>
 #include <stdexcept>
-template <typename T>
+#include <utility>
+template <typename T, typename Allocator = std::allocator<T>>
 class DoublyLinkedList {
  private:
   struct ListNode {
     T value;
     ListNode *previous;
     ListNode *next;
-    ListNode(const T &value, ListNode *previous = nullptr,
-             ListNode *next = nullptr)
-        : value(value), previous(previous), next(next) {}
+    template <typename V>
+    ListNode(V &&value, ListNode *previous = nullptr, ListNode *next = nullptr)
+        : value(std::forward<V>(value)), previous(previous), next(next) {}
   };
+  using NodeAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<ListNode>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  static constexpr bool PROPAGATE_ON_MOVE =
+      NodeTraits::propagate_on_container_move_assignment::value;
+
+  [[no_unique_address]] NodeAllocator nodeAllocator;
   ListNode *head = nullptr;
   ListNode *tail = nullptr;
   size_t size = 0;
 
+  template <typename... Args>
+  ListNode *createNode(Args &&...args);
+  void destroyNode(ListNode *node);
+  void linkBack(ListNode *node);
   void free();
 
  public:
@@ -42,16 +55,22 @@ class DoublyLinkedList {
     T &operator*() const { return this->current->value; }
   };
   DoublyLinkedList();
-  DoublyLinkedList(size_t size, const T &value);
-  DoublyLinkedList(const std::initializer_list<T> &initList);
+  explicit DoublyLinkedList(const Allocator &allocator);
+  DoublyLinkedList(size_t size, const T &value,
+                   const Allocator &allocator = Allocator());
+  DoublyLinkedList(const std::initializer_list<T> &initList,
+                   const Allocator &allocator = Allocator());
   DoublyLinkedList(const DoublyLinkedList &other);
   DoublyLinkedList &operator=(const DoublyLinkedList &other);
   DoublyLinkedList(DoublyLinkedList &&other) noexcept;
-  DoublyLinkedList &operator=(DoublyLinkedList &&other) noexcept;
+  DoublyLinkedList &operator=(DoublyLinkedList &&other) noexcept(
+      PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value);
   ~DoublyLinkedList();
+  [[nodiscard]] Allocator getAllocator() const;
   [[nodiscard]] size_t getSize() const;
   void pushFront(const T &value);
   void pushBack(const T &value);
+  void pushBack(T &&value);
   void popFront();
   void popBack();
   T erase(size_t index);
@@ -61,57 +80,87 @@ class DoublyLinkedList {
   Iterator end();
   Iterator begin() const;
   Iterator end() const;
-  template <typename S>
+  template <typename S, typename A>
   friend std::ostream &operator<<(std::ostream &outputStream,
-                                  const DoublyLinkedList<S> &list);
+                                  const DoublyLinkedList<S, A> &list);
 };
 
-template <typename T>
-void DoublyLinkedList<T>::free() {
+template <typename T, typename Allocator>
+template <typename... Args>
+DoublyLinkedList<T, Allocator>::ListNode *
+DoublyLinkedList<T, Allocator>::createNode(Args &&...args) {
+  ListNode *node = NodeTraits::allocate(this->nodeAllocator, 1);
+  try {
+    NodeTraits::construct(this->nodeAllocator, node,
+                          std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits::deallocate(this->nodeAllocator, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::destroyNode(ListNode *node) {
+  NodeTraits::destroy(this->nodeAllocator, node);
+  NodeTraits::deallocate(this->nodeAllocator, node, 1);
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::free() {
   ListNode *next = nullptr;
   while (head != nullptr) {
     next = head->next;
-    delete head;
+    destroyNode(head);
     head = next;
   }
   this->tail = nullptr;
   this->size = 0;
 }
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList() {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList() {
   this->head = nullptr;
   this->tail = nullptr;
   this->size = 0;
 }
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(size_t size, const T &value) {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(const Allocator &allocator)
+    : nodeAllocator(allocator) {}
+
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(size_t size, const T &value,
+                                                 const Allocator &allocator)
+    : nodeAllocator(allocator) {
   for (size_t i = 0; i < size; i++) {
     pushBack(value);
   }
 }
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(
-    const std::initializer_list<T> &initList) {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(
+    const std::initializer_list<T> &initList, const Allocator &allocator)
+    : nodeAllocator(allocator) {
   for (auto &element : initList) {
     pushBack(element);
   }
 }
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(const DoublyLinkedList &other) {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(const DoublyLinkedList &other)
+    : nodeAllocator(NodeTraits::select_on_container_copy_construction(
+          other.nodeAllocator)) {
   if (other.head != nullptr) {
     ListNode *otherNode = other.head;
-    this->head = new ListNode(otherNode->value, nullptr, nullptr);
+    this->head = createNode(otherNode->value, nullptr, nullptr);
     ListNode *previous = this->head;
     ListNode *currentNode = nullptr;
 
     otherNode = otherNode->next;
 
     while (otherNode != nullptr) {
-      currentNode = new ListNode(otherNode->value, previous, nullptr);
+      currentNode = createNode(otherNode->value, previous, nullptr);
       previous->next = currentNode;
       previous = previous->next;
       otherNode = otherNode->next;
@@ -121,21 +170,24 @@ DoublyLinkedList<T>::DoublyLinkedList(const DoublyLinkedList &other) {
   this->size = other.size;
 }
 
-template <typename T>
-DoublyLinkedList<T> &DoublyLinkedList<T>::operator=(
-    const DoublyLinkedList<T> &other) {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator> &DoublyLinkedList<T, Allocator>::operator=(
+    const DoublyLinkedList<T, Allocator> &other) {
   if (this != &other) {
     free();
+    if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+      this->nodeAllocator = other.nodeAllocator;
+    }
     if (other.head != nullptr) {
       ListNode *otherNode = other.head;
-      this->head = new ListNode(otherNode->value, nullptr, nullptr);
+      this->head = createNode(otherNode->value, nullptr, nullptr);
       ListNode *previous = head;
       ListNode *currentNode = nullptr;
 
       otherNode = otherNode->next;
 
       while (otherNode != nullptr) {
-        currentNode = new ListNode(otherNode->value, previous, nullptr);
+        currentNode = createNode(otherNode->value, previous, nullptr);
         previous->next = currentNode;
         previous = previous->next;
         otherNode = otherNode->next;
@@ -147,8 +199,10 @@ DoublyLinkedList<T> &DoublyLinkedList<T>::operator=(
   return *this;
 }
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList<T> &&other) noexcept {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(
+    DoublyLinkedList<T, Allocator> &&other) noexcept
+    : nodeAllocator(std::move(other.nodeAllocator)) {
   this->size = other.size;
   this->head = other.head;
   this->tail = other.tail;
@@ -158,11 +212,22 @@ DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList<T> &&other) noexcept {
   other.tail = nullptr;
 }
 
-template <typename T>
-DoublyLinkedList<T> &DoublyLinkedList<T>::operator=(
-    DoublyLinkedList<T> &&other) noexcept {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator> &DoublyLinkedList<T, Allocator>::operator=(
+    DoublyLinkedList<T, Allocator> &&other)
+    noexcept(PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value) {
   if (this != &other) {
     free();
+    if constexpr (PROPAGATE_ON_MOVE) {
+      this->nodeAllocator = std::move(other.nodeAllocator);
+    } else if (this->nodeAllocator != other.nodeAllocator) {
+      // the nodes belong to the other resource, relink moved values instead
+      for (auto &element : other) {
+        pushBack(std::move(element));
+      }
+      other.free();
+      return *this;
+    }
     this->size = other.size;
     this->head = other.head;
     this->tail = other.tail;
@@ -174,51 +239,65 @@ DoublyLinkedList<T> &DoublyLinkedList<T>::operator=(
   return *this;
 }
 
-template <typename T>
-DoublyLinkedList<T>::~DoublyLinkedList() {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
   free();
 }
 
-template <typename T>
-[[nodiscard]] size_t DoublyLinkedList<T>::getSize() const {
+template <typename T, typename Allocator>
+Allocator DoublyLinkedList<T, Allocator>::getAllocator() const {
+  return Allocator(this->nodeAllocator);
+}
+
+template <typename T, typename Allocator>
+[[nodiscard]] size_t DoublyLinkedList<T, Allocator>::getSize() const {
   return this->size;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::pushFront(const T &value) {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::pushFront(const T &value) {
   if (head == nullptr) {
-    this->head = new ListNode(value, nullptr, nullptr);
+    this->head = createNode(value, nullptr, nullptr);
     this->tail = this->head;
   } else {
-    auto temp = new ListNode(value, nullptr, this->head);
+    auto temp = createNode(value, nullptr, this->head);
     head->previous = temp;
     this->head = temp;
   }
   this->size++;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::pushBack(const T &value) {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::pushBack(const T &value) {
+  linkBack(createNode(value, nullptr, nullptr));
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::pushBack(T &&value) {
+  linkBack(createNode(std::move(value), nullptr, nullptr));
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::linkBack(ListNode *node) {
   if (this->tail == nullptr) {
-    this->tail = new ListNode(value, nullptr, nullptr);
-    this->head = this->tail;
+    this->head = node;
   } else {
-    auto temp = new ListNode(value, this->tail, nullptr);
-    this->tail->next = temp;
-    this->tail = temp;
+    node->previous = this->tail;
+    this->tail->next = node;
   }
+  this->tail = node;
   this->size++;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::popFront() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::popFront() {
   if (this->head != nullptr) {
     ListNode *temp = this->head;
     this->head = this->head->next;
     if (this->head) {
       this->head->previous = nullptr;
     }
-    delete temp;
+    destroyNode(temp);
     this->size--;
   }
   if (this->head == nullptr) {
@@ -226,12 +305,12 @@ void DoublyLinkedList<T>::popFront() {
   }
 }
 
-template <typename T>
-void DoublyLinkedList<T>::popBack() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::popBack() {
   if (this->tail != nullptr) {
     ListNode *temp = this->tail;
     this->tail = this->tail->previous;
-    delete temp;
+    destroyNode(temp);
     if (this->tail) {
       this->tail->next = nullptr;
     }
@@ -242,8 +321,8 @@ void DoublyLinkedList<T>::popBack() {
   }
 }
 
-template <typename T>
-T DoublyLinkedList<T>::erase(size_t index) {
+template <typename T, typename Allocator>
+T DoublyLinkedList<T, Allocator>::erase(size_t index) {
   if (index >= this->size) {
     throw std::out_of_range("Invalid index for deletion");
   }
@@ -262,13 +341,13 @@ T DoublyLinkedList<T>::erase(size_t index) {
     this->tail = toBeErased->previous;
   }
   T temp = toBeErased->value;
-  delete toBeErased;
+  destroyNode(toBeErased);
   this->size--;
   return temp;
 }
 
-template <typename T>
-T DoublyLinkedList<T>::operator[](size_t index) const {
+template <typename T, typename Allocator>
+T DoublyLinkedList<T, Allocator>::operator[](size_t index) const {
   if (index >= this->size) {
     throw std::out_of_range("Index out of range");
   }
@@ -279,8 +358,8 @@ T DoublyLinkedList<T>::operator[](size_t index) const {
   return toBeReturned->value;
 }
 
-template <typename T>
-T &DoublyLinkedList<T>::operator[](size_t index) {
+template <typename T, typename Allocator>
+T &DoublyLinkedList<T, Allocator>::operator[](size_t index) {
   if (index >= this->size) {
     throw std::out_of_range("Index out of range");
   }
@@ -292,29 +371,32 @@ T &DoublyLinkedList<T>::operator[](size_t index) {
   return toBeReturned->value;
 }
 
-template <typename T>
-DoublyLinkedList<T>::Iterator DoublyLinkedList<T>::begin() {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::Iterator DoublyLinkedList<T, Allocator>::begin(
+    ) {
   return Iterator(this->head);
 }
 
-template <typename T>
-DoublyLinkedList<T>::Iterator DoublyLinkedList<T>::end() {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::Iterator DoublyLinkedList<T, Allocator>::end() {
   return Iterator(nullptr);
 }
 
-template <typename T>
-DoublyLinkedList<T>::Iterator DoublyLinkedList<T>::begin() const {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::Iterator DoublyLinkedList<T, Allocator>::begin(
+    ) const {
   return Iterator(this->head);
 }
 
-template <typename T>
-DoublyLinkedList<T>::Iterator DoublyLinkedList<T>::end() const {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::Iterator DoublyLinkedList<T, Allocator>::end(
+    ) const {
   return Iterator(nullptr);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 std::ostream &operator<<(std::ostream &outputStream,
-                         const DoublyLinkedList<T> &list) {
+                         const DoublyLinkedList<T, Allocator> &list) {
   for (auto num : list) {
     outputStream << num << " ";
   }
@@ -3,21 +3,35 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <memory>
 #include <ostream>
 #include <stdexcept>
-template <typename T>
+#include <utility>
+template <typename T, typename Allocator = std::allocator<T>>
 class SinglyLinkedList {
  private:
   struct ListNode {
     T value;
     ListNode *next;
-    ListNode(const T &value, ListNode *next = nullptr)
-        : value(value), next(next) {}
+    template <typename V>
+    ListNode(V &&value, ListNode *next = nullptr)
+        : value(std::forward<V>(value)), next(next) {}
   };
+  using NodeAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<ListNode>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  static constexpr bool PROPAGATE_ON_MOVE =
+      NodeTraits::propagate_on_container_move_assignment::value;
+
+  [[no_unique_address]] NodeAllocator nodeAllocator;
   ListNode *head = nullptr;
   ListNode *tail = nullptr;
   size_t size = 0;
 
+  template <typename... Args>
+  ListNode *createNode(Args &&...args);
+  void destroyNode(ListNode *node);
+  void linkBack(ListNode *node);
   void free();
 
  public:
@@ -40,16 +54,22 @@ class SinglyLinkedList {
     T &operator*() const { return this->current->value; }
   };
   SinglyLinkedList();
-  SinglyLinkedList(size_t size, const T &value);
-  SinglyLinkedList(const std::initializer_list<T> &initList);
+  explicit SinglyLinkedList(const Allocator &allocator);
+  SinglyLinkedList(size_t size, const T &value,
+                   const Allocator &allocator = Allocator());
+  SinglyLinkedList(const std::initializer_list<T> &initList,
+                   const Allocator &allocator = Allocator());
   SinglyLinkedList(const SinglyLinkedList &other);
   SinglyLinkedList &operator=(const SinglyLinkedList &other);
   SinglyLinkedList(SinglyLinkedList &&other) noexcept;
-  SinglyLinkedList &operator=(SinglyLinkedList &&other) noexcept;
+  SinglyLinkedList &operator=(SinglyLinkedList &&other) noexcept(
+      PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value);
   ~SinglyLinkedList();
+  [[nodiscard]] Allocator getAllocator() const;
   [[nodiscard]] size_t getSize() const;
   void pushFront(const T &value);
   void pushBack(const T &value);
+  void pushBack(T &&value);
   void popFront();
   T erase(size_t index);
   T operator[](size_t index) const;
@@ -58,56 +78,86 @@ class SinglyLinkedList {
   Iterator end();
   Iterator begin() const;
   Iterator end() const;
-  template <typename S>
+  template <typename S, typename A>
   friend std::ostream &operator<<(std::ostream &outputStream,
-                                  const SinglyLinkedList<S> &list);
+                                  const SinglyLinkedList<S, A> &list);
 };
 
-template <typename T>
-void SinglyLinkedList<T>::free() {
+template <typename T, typename Allocator>
+template <typename... Args>
+SinglyLinkedList<T, Allocator>::ListNode *
+SinglyLinkedList<T, Allocator>::createNode(Args &&...args) {
+  ListNode *node = NodeTraits::allocate(this->nodeAllocator, 1);
+  try {
+    NodeTraits::construct(this->nodeAllocator, node,
+                          std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits::deallocate(this->nodeAllocator, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::destroyNode(ListNode *node) {
+  NodeTraits::destroy(this->nodeAllocator, node);
+  NodeTraits::deallocate(this->nodeAllocator, node, 1);
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::free() {
   ListNode *next = nullptr;
   while (head != nullptr) {
     next = head->next;
-    delete head;
+    destroyNode(head);
     head = next;
   }
   this->tail = nullptr;
   this->size = 0;
 }
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList() {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList() {
   this->head = nullptr;
   this->tail = nullptr;
   this->size = 0;
 }
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList(size_t size, const T &value) {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(const Allocator &allocator)
+    : nodeAllocator(allocator) {}
+
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(size_t size, const T &value,
+                                                 const Allocator &allocator)
+    : nodeAllocator(allocator) {
   for (size_t i = 0; i < size; i++) {
     pushBack(value);
   }
 }
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList(
-    const std::initializer_list<T> &initList) {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(
+    const std::initializer_list<T> &initList, const Allocator &allocator)
+    : nodeAllocator(allocator) {
   for (auto &element : initList) {
     pushBack(element);
   }
 }
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList &other) {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(const SinglyLinkedList &other)
+    : nodeAllocator(NodeTraits::select_on_container_copy_construction(
+          other.nodeAllocator)) {
   if (other.head != nullptr) {
     ListNode *otherNode = other.head;
-    this->head = new ListNode(otherNode->value, nullptr);
+    this->head = createNode(otherNode->value, nullptr);
     ListNode *previous = this->head;
 
     otherNode = otherNode->next;
 
     while (otherNode != nullptr) {
-      previous->next = new ListNode(otherNode->value, nullptr);
+      previous->next = createNode(otherNode->value, nullptr);
       previous = previous->next;
       otherNode = otherNode->next;
     }
@@ -116,20 +166,23 @@ SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList &other) {
   this->size = other.size;
 }
 
-template <typename T>
-SinglyLinkedList<T> &SinglyLinkedList<T>::operator=(
-    const SinglyLinkedList<T> &other) {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator> &SinglyLinkedList<T, Allocator>::operator=(
+    const SinglyLinkedList<T, Allocator> &other) {
   if (this != &other) {
     free();
+    if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+      this->nodeAllocator = other.nodeAllocator;
+    }
     if (other.head != nullptr) {
       ListNode *otherNode = other.head;
-      this->head = new ListNode(otherNode->value, nullptr);
+      this->head = createNode(otherNode->value, nullptr);
       ListNode *previous = head;
 
       otherNode = otherNode->next;
 
       while (otherNode != nullptr) {
-        previous->next = new ListNode(otherNode->value, nullptr);
+        previous->next = createNode(otherNode->value, nullptr);
         previous = previous->next;
         otherNode = otherNode->next;
       }
@@ -140,8 +193,10 @@ SinglyLinkedList<T> &SinglyLinkedList<T>::operator=(
   return *this;
 }
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList(SinglyLinkedList<T> &&other) noexcept {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(
+    SinglyLinkedList<T, Allocator> &&other) noexcept
+    : nodeAllocator(std::move(other.nodeAllocator)) {
   this->size = other.size;
   this->head = other.head;
   this->tail = other.tail;
@@ -151,11 +206,23 @@ SinglyLinkedList<T>::SinglyLinkedList(SinglyLinkedList<T> &&other) noexcept {
   other.tail = nullptr;
 }
 
-template <typename T>
-SinglyLinkedList<T> &SinglyLinkedList<T>::operator=(
-    SinglyLinkedList<T> &&other) noexcept {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator> &SinglyLinkedList<T, Allocator>::operator=(
+    SinglyLinkedList<T, Allocator> &&other)
+    noexcept(PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value) {
   if (this != &other) {
     free();
+    if constexpr (PROPAGATE_ON_MOVE) {
+      this->nodeAllocator = std::move(other.nodeAllocator);
+    } else if (this->nodeAllocator != other.nodeAllocator) {
+      // this allocator cannot free the other list's nodes, so only the
+      // values move over
+      for (auto &element : other) {
+        pushBack(std::move(element));
+      }
+      other.free();
+      return *this;
+    }
     this->size = other.size;
     this->head = other.head;
     this->tail = other.tail;
@@ -167,47 +234,60 @@ SinglyLinkedList<T> &SinglyLinkedList<T>::operator=(
   return *this;
 }
 
-template <typename T>
-SinglyLinkedList<T>::~SinglyLinkedList() {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::~SinglyLinkedList() {
   free();
 }
 
-template <typename T>
-[[nodiscard]] size_t SinglyLinkedList<T>::getSize() const {
+template <typename T, typename Allocator>
+Allocator SinglyLinkedList<T, Allocator>::getAllocator() const {
+  return Allocator(this->nodeAllocator);
+}
+
+template <typename T, typename Allocator>
+[[nodiscard]] size_t SinglyLinkedList<T, Allocator>::getSize() const {
   return this->size;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::pushFront(const T &value) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::pushFront(const T &value) {
   if (head == nullptr) {
-    this->head = new ListNode(value, nullptr);
+    this->head = createNode(value, nullptr);
     this->tail = this->head;
   } else {
-    auto temp = new ListNode(value, this->head);
+    auto temp = createNode(value, this->head);
     this->head = temp;
   }
   this->size++;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::pushBack(const T &value) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::pushBack(const T &value) {
+  linkBack(createNode(value, nullptr));
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::pushBack(T &&value) {
+  linkBack(createNode(std::move(value), nullptr));
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::linkBack(ListNode *node) {
   if (this->tail == nullptr) {
-    this->tail = new ListNode(value, nullptr);
-    this->head = this->tail;
+    this->head = node;
   } else {
-    auto temp = new ListNode(value, nullptr);
-    this->tail->next = temp;
-    this->tail = temp;
+    this->tail->next = node;
   }
+  this->tail = node;
   this->size++;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::popFront() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::popFront() {
   if (this->head != nullptr) {
     ListNode *temp = this->head;
     this->head = this->head->next;
-    delete temp;
+    destroyNode(temp);
     this->size--;
   }
   if (this->head == nullptr) {
@@ -215,8 +295,8 @@ void SinglyLinkedList<T>::popFront() {
   }
 }
 
-template <typename T>
-T SinglyLinkedList<T>::erase(size_t index) {
+template <typename T, typename Allocator>
+T SinglyLinkedList<T, Allocator>::erase(size_t index) {
   if (index >= this->size) {
     throw std::out_of_range("Invalid index for deletion");
   }
@@ -236,13 +316,13 @@ T SinglyLinkedList<T>::erase(size_t index) {
   if (prev->next == nullptr) {
     this->tail = prev;
   }
-  delete iterator;
+  destroyNode(iterator);
   this->size--;
   return temp;
 }
 
-template <typename T>
-T SinglyLinkedList<T>::operator[](size_t index) const {
+template <typename T, typename Allocator>
+T SinglyLinkedList<T, Allocator>::operator[](size_t index) const {
   if (index >= this->size) {
     throw std::out_of_range("Index out of range");
   }
@@ -253,8 +333,8 @@ T SinglyLinkedList<T>::operator[](size_t index) const {
   return toBeReturned->value;
 }
 
-template <typename T>
-T &SinglyLinkedList<T>::operator[](size_t index) {
+template <typename T, typename Allocator>
+T &SinglyLinkedList<T, Allocator>::operator[](size_t index) {
   if (index >= this->size) {
     throw std::out_of_range("Index out of range");
   }
@@ -266,29 +346,32 @@ T &SinglyLinkedList<T>::operator[](size_t index) {
   return toBeReturned->value;
 }
 
-template <typename T>
-SinglyLinkedList<T>::Iterator SinglyLinkedList<T>::begin() {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::Iterator SinglyLinkedList<T, Allocator>::begin(
+    ) {
   return Iterator(this->head);
 }
 
-template <typename T>
-SinglyLinkedList<T>::Iterator SinglyLinkedList<T>::end() {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::Iterator SinglyLinkedList<T, Allocator>::end() {
   return Iterator(nullptr);
 }
 
-template <typename T>
-SinglyLinkedList<T>::Iterator SinglyLinkedList<T>::begin() const {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::Iterator SinglyLinkedList<T, Allocator>::begin(
+    ) const {
   return Iterator(this->head);
 }
 
-template <typename T>
-SinglyLinkedList<T>::Iterator SinglyLinkedList<T>::end() const {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::Iterator SinglyLinkedList<T, Allocator>::end(
+    ) const {
   return Iterator(nullptr);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 std::ostream &operator<<(std::ostream &outputStream,
-                         const SinglyLinkedList<T> &list) {
+                         const SinglyLinkedList<T, Allocator> &list) {
   for (auto num : list) {
     outputStream << num << " ";
   }
@@ -0,0 +1,67 @@
+#ifndef MALLOC_ALLOCATOR_H
+#define MALLOC_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Allocator on top of malloc that also exposes realloc. Vector uses
+// reallocate() for trivially copyable elements, which lets the C library grow
+// large blocks in place or remap them (mremap) instead of copying.
+template <typename T>
+class MallocAllocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "malloc does not guarantee over-aligned storage");
+
+ public:
+  using value_type = T;
+
+  MallocAllocator() = default;
+  template <typename U>
+  MallocAllocator(const MallocAllocator<U> & /*other*/) noexcept {}
+
+  T *allocate(size_t count);
+  void deallocate(T *pointer, size_t count) noexcept;
+  T *reallocate(T *pointer, size_t oldCount, size_t newCount);
+
+  template <typename U>
+  bool operator==(const MallocAllocator<U> & /*other*/) const noexcept {
+    return true;
+  }
+};
+
+template <typename T>
+T *MallocAllocator<T>::allocate(size_t count) {
+  if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+    throw std::bad_array_new_length();
+  }
+  void *pointer = std::malloc(count * sizeof(T));
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return static_cast<T *>(pointer);
+}
+
+template <typename T>
+void MallocAllocator<T>::deallocate(T *pointer, size_t /*count*/) noexcept {
+  std::free(pointer);
+}
+
+template <typename T>
+T *MallocAllocator<T>::reallocate(T *pointer, size_t /*oldCount*/,
+                                  size_t newCount) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "realloc may move the bytes of the elements");
+  if (newCount > std::numeric_limits<size_t>::max() / sizeof(T)) {
+    throw std::bad_array_new_length();
+  }
+  void *newPointer = std::realloc(pointer, newCount * sizeof(T));
+  if (newPointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return static_cast<T *>(newPointer);
+}
+
+#endif  // !MALLOC_ALLOCATOR_H
@@ -0,0 +1,46 @@
+#ifndef MONOTONIC_ARENA_H
+#define MONOTONIC_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Bump allocator: deallocate is a no-op and release() drops everything at once.
+// Not synchronized, meant to be owned by a single request or thread.
+class MonotonicArena : public std::pmr::memory_resource {
+ private:
+  struct Chunk {
+    Chunk *previous;
+    size_t size;
+  };
+  std::pmr::memory_resource *upstream;
+  Chunk *chunks = nullptr;
+  std::byte *current = nullptr;
+  size_t remaining = 0;
+  size_t nextChunkSize;
+  std::byte *initialBuffer = nullptr;
+  size_t initialSize = 0;
+  size_t bytesAllocated = 0;
+
+  void addChunk(size_t minimumBytes, size_t alignment);
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override;
+
+ public:
+  explicit MonotonicArena(
+      size_t initialChunkSize = 4096,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  MonotonicArena(
+      void *buffer, size_t bufferSize,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  MonotonicArena(const MonotonicArena &other) = delete;
+  MonotonicArena &operator=(const MonotonicArena &other) = delete;
+  ~MonotonicArena() override;
+  void release();
+  [[nodiscard]] size_t getBytesAllocated() const;
+};
+
+#endif  // !MONOTONIC_ARENA_H
@@ -0,0 +1,44 @@
+#ifndef POOL_RESOURCE_H
+#define POOL_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Fixed-size block pool with an intrusive free list. Requests that do not fit
+// in a block are forwarded upstream. Not synchronized.
+class PoolResource : public std::pmr::memory_resource {
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+  struct Chunk {
+    Chunk *previous;
+  };
+  std::pmr::memory_resource *upstream;
+  size_t blockSize;
+  size_t blocksPerChunk;
+  Chunk *chunks = nullptr;
+  FreeBlock *freeList = nullptr;
+
+  void addChunk();
+  [[nodiscard]] bool fits(size_t bytes, size_t alignment) const;
+  [[nodiscard]] size_t chunkBytes() const;
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override;
+
+ public:
+  explicit PoolResource(
+      size_t blockSize, size_t blocksPerChunk = 256,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  PoolResource(const PoolResource &other) = delete;
+  PoolResource &operator=(const PoolResource &other) = delete;
+  ~PoolResource() override;
+  void release();
+  [[nodiscard]] size_t getBlockSize() const;
+};
+
+#endif  // !POOL_RESOURCE_H
@@ -0,0 +1,246 @@
+#ifndef LEARNED_INDEX_H
+#define LEARNED_INDEX_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "Searching.h"
+
+#define LEARNED_INDEX_MAX_ERROR 32
+#define LEARNED_INDEX_RADIX_BITS 18
+
+// RadixSpline over sorted 64-bit keys: a piecewise-linear model of the
+// position of every key, whose segments are found through a table indexed
+// by the top bits of the key. A lookup interpolates inside one segment and
+// finishes with a binary search over at most 2 * getMaxError() + 1 keys.
+// The index keeps a pointer to the keys, which must outlive it unchanged.
+class LearnedIndex {
+ private:
+  struct Knot {
+    uint64_t key;
+    size_t position;
+  };
+
+  const uint64_t *data = nullptr;
+  size_t size = 0;
+  uint64_t minKey = 0;
+  uint64_t maxKey = 0;
+  size_t maxError = 0;
+  unsigned shift = 0;
+  std::vector<Knot> knots;
+  // the first knot of every key prefix, plus one past the last prefix
+  std::vector<uint32_t> radixTable;
+
+  template <typename Visit>
+  void forEachPoint(Visit visit) const;
+  void fitSpline(size_t errorBound);
+  void buildRadixTable(unsigned radixBits);
+  [[nodiscard]] size_t estimatePosition(uint64_t key) const;
+
+ public:
+  explicit LearnedIndex(const std::vector<uint64_t> &keys,
+                        size_t errorBound = LEARNED_INDEX_MAX_ERROR,
+                        unsigned radixBits = LEARNED_INDEX_RADIX_BITS);
+  // the index would point into the temporary once it is gone
+  LearnedIndex(std::vector<uint64_t> &&keys,
+               size_t errorBound = LEARNED_INDEX_MAX_ERROR,
+               unsigned radixBits = LEARNED_INDEX_RADIX_BITS) = delete;
+  // Position of the first key not less than key, getSize() if none
+  [[nodiscard]] size_t lowerBound(uint64_t key) const;
+  [[nodiscard]] std::optional<size_t> find(uint64_t key) const;
+  [[nodiscard]] size_t getSize() const;
+  // Largest distance between a predicted and a true position
+  [[nodiscard]] size_t getMaxError() const;
+  [[nodiscard]] size_t getSegmentCount() const;
+  // Bytes taken by the spline and the radix table, without the keys
+  [[nodiscard]] size_t getModelSize() const;
+};
+
+inline LearnedIndex::LearnedIndex(const std::vector<uint64_t> &keys,
+                                  size_t errorBound, unsigned radixBits)
+    : data(keys.data()), size(keys.size()) {
+  if (!std::ranges::is_sorted(keys)) {
+    throw std::invalid_argument("Index keys must be sorted");
+  }
+  if (radixBits > 30) {
+    throw std::invalid_argument("Radix table is limited to 2^30 entries");
+  }
+  if (this->size == 0) {
+    return;
+  }
+  this->minKey = keys.front();
+  this->maxKey = keys.back();
+  fitSpline(errorBound);
+  if (this->knots.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("Too many spline segments");
+  }
+  buildRadixTable(radixBits);
+  // the bound is measured with the lookup arithmetic itself, so rounding
+  // can never push a key outside the last-mile window
+  forEachPoint([this](uint64_t key, size_t position) {
+    if (key > this->minKey) {
+      size_t estimate = estimatePosition(key);
+      this->maxError = std::max(this->maxError, estimate > position
+                                                    ? estimate - position
+                                                    : position - estimate);
+    }
+  });
+}
+
+// The points the spline has to pass near: every distinct key at its first
+// position, and key + 1 at the position of the next distinct key. The
+// second point pins the gap after a run of duplicates, so any integer
+// probe lies between two points with the same answer.
+template <typename Visit>
+void LearnedIndex::forEachPoint(Visit visit) const {
+  for (size_t i = 0; i < this->size; i++) {
+    if (i > 0 && this->data[i] == this->data[i - 1]) {
+      continue;
+    }
+    if (i > 0 && this->data[i - 1] + 1 < this->data[i]) {
+      visit(this->data[i - 1] + 1, i);
+    }
+    visit(this->data[i], i);
+  }
+}
+
+// Greedy spline corridor: the segment from the last knot may end at any
+// slope between the lowest and highest one that keeps every point since
+// within errorBound. When a point falls outside those slopes, the point
+// before it becomes a knot and a new corridor starts there.
+inline void LearnedIndex::fitSpline(size_t errorBound) {
+  auto error = static_cast<long double>(errorBound);
+  Knot previous{};
+  bool hasCorridor = false;
+  long double upperDx = 0;
+  long double upperDy = 0;
+  long double lowerDx = 0;
+  long double lowerDy = 0;
+  auto openCorridor = [&](long double dx, long double dy) {
+    upperDx = lowerDx = dx;
+    upperDy = dy + error;
+    lowerDy = dy - error;
+    hasCorridor = true;
+  };
+  forEachPoint([&](uint64_t key, size_t position) {
+    if (this->knots.empty()) {
+      this->knots.push_back({key, position});
+      previous = {key, position};
+      return;
+    }
+    const Knot &base = this->knots.back();
+    auto dx = static_cast<long double>(key - base.key);
+    auto dy = static_cast<long double>(position) -
+              static_cast<long double>(base.position);
+    if (!hasCorridor) {
+      openCorridor(dx, dy);
+    } else if (dy * upperDx > upperDy * dx || dy * lowerDx < lowerDy * dx) {
+      this->knots.push_back(previous);
+      openCorridor(static_cast<long double>(key - previous.key),
+                   static_cast<long double>(position) -
+                       static_cast<long double>(previous.position));
+    } else {
+      if ((dy + error) * upperDx < upperDy * dx) {
+        upperDx = dx;
+        upperDy = dy + error;
+      }
+      if ((dy - error) * lowerDx > lowerDy * dx) {
+        lowerDx = dx;
+        lowerDy = dy - error;
+      }
+    }
+    previous = {key, position};
+  });
+  if (previous.key != this->knots.back().key) {
+    this->knots.push_back(previous);
+  }
+}
+
+// Keeps no more prefixes than knots; a finer table would only repeat
+// entries. At least one bit keeps the shift below 64 for keys spanning the
+// whole range.
+inline void LearnedIndex::buildRadixTable(unsigned radixBits) {
+  radixBits = std::clamp<unsigned>(radixBits, 1,
+                                   std::bit_width(this->knots.size()));
+  auto rangeBits =
+      static_cast<unsigned>(std::bit_width(this->maxKey - this->minKey));
+  this->shift = rangeBits > radixBits ? rangeBits - radixBits : 0;
+  size_t prefixes = ((this->maxKey - this->minKey) >> this->shift) + 2;
+  this->radixTable.resize(prefixes);
+  size_t knot = 0;
+  for (size_t prefix = 0; prefix < prefixes; prefix++) {
+    while (knot < this->knots.size() &&
+           (this->knots[knot].key - this->minKey) >> this->shift < prefix) {
+      knot++;
+    }
+    this->radixTable[prefix] = static_cast<uint32_t>(knot);
+  }
+}
+
+// Only called for minKey < key <= maxKey. Knots of earlier prefixes are
+// below key and knots of later ones above it, so the segment ending at the
+// first knot not below key is found among the knots of key's own prefix
+// and the first knot after them.
+inline size_t LearnedIndex::estimatePosition(uint64_t key) const {
+  size_t prefix = (key - this->minKey) >> this->shift;
+  const Knot *first = this->knots.data() + this->radixTable[prefix];
+  const Knot *last =
+      this->knots.data() +
+      std::min<size_t>(this->radixTable[prefix + 1] + 1, this->knots.size());
+  const Knot *right =
+      ::lowerBound(first, last, key, std::ranges::less(), &Knot::key);
+  const Knot *left = right - 1;
+  double slope = static_cast<double>(right->position - left->position) /
+                 static_cast<double>(right->key - left->key);
+  double estimate = static_cast<double>(left->position) +
+                    static_cast<double>(key - left->key) * slope;
+  return static_cast<size_t>(estimate + 0.5);
+}
+
+inline size_t LearnedIndex::lowerBound(uint64_t key) const {
+  if (this->size == 0 || key <= this->minKey) {
+    return 0;
+  }
+  if (key > this->maxKey) {
+    return this->size;
+  }
+  size_t estimate = estimatePosition(key);
+  size_t low = estimate > this->maxError ? estimate - this->maxError : 0;
+  size_t high = std::min(estimate + this->maxError + 1, this->size);
+  return static_cast<size_t>(
+      ::lowerBound(this->data + low, this->data + high, key) - this->data);
+}
+
+inline std::optional<size_t> LearnedIndex::find(uint64_t key) const {
+  size_t position = lowerBound(key);
+  if (position == this->size || this->data[position] != key) {
+    return {};
+  }
+  return position;
+}
+
+inline size_t LearnedIndex::getSize() const {
+  return this->size;
+}
+
+inline size_t LearnedIndex::getMaxError() const {
+  return this->maxError;
+}
+
+inline size_t LearnedIndex::getSegmentCount() const {
+  return this->knots.empty() ? 0 : this->knots.size() - 1;
+}
+
+inline size_t LearnedIndex::getModelSize() const {
+  return this->knots.size() * sizeof(Knot) +
+         this->radixTable.size() * sizeof(uint32_t);
+}
+
+#endif  // !LEARNED_INDEX_H
@@ -1,10 +1,233 @@
 #ifndef SEARCHING_H
 #define SEARCHING_H
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Hints the cache to fetch the element at it; a no-op for iterators over
+// storage that is not contiguous
+template <typename RandomIt>
+void prefetchElement(RandomIt it) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (std::contiguous_iterator<RandomIt>) {
+    __builtin_prefetch(std::to_address(it));
+  }
+#endif
+}
+
+// First position in the sorted range [first, last) whose element is not
+// less than value. The loop halves the range without branching on the
+// comparison: the result only picks the next base, which compiles to a
+// conditional move, so the CPU never mispredicts. Both elements the next
+// step may probe are prefetched, hiding part of the cache miss per level.
+template <std::random_access_iterator RandomIt, typename T,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::indirect_strict_weak_order<
+      Compare, const T *, std::projected<RandomIt, Projection>>
+RandomIt lowerBound(RandomIt first, RandomIt last, const T &value,
+                    Compare compare = {}, Projection projection = {}) {
+  auto length = last - first;
+  if (length == 0) {
+    return first;
+  }
+  RandomIt base = first;
+  while (length > 1) {
+    auto half = length / 2;
+    auto nextHalf = (length - half) / 2;
+    prefetchElement(base + nextHalf);
+    prefetchElement(base + half + nextHalf);
+    bool less = std::invoke(compare, std::invoke(projection, base[half]),
+                            value);
+    base = less ? base + half : base;
+    length -= half;
+  }
+  return base + static_cast<std::ptrdiff_t>(
+                    std::invoke(compare, std::invoke(projection, *base),
+                                value));
+}
+
+// First position in the sorted range [first, last) whose element is
+// greater than value, with the same branch-free loop as lowerBound
+template <std::random_access_iterator RandomIt, typename T,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::indirect_strict_weak_order<
+      Compare, const T *, std::projected<RandomIt, Projection>>
+RandomIt upperBound(RandomIt first, RandomIt last, const T &value,
+                    Compare compare = {}, Projection projection = {}) {
+  auto length = last - first;
+  if (length == 0) {
+    return first;
+  }
+  RandomIt base = first;
+  while (length > 1) {
+    auto half = length / 2;
+    auto nextHalf = (length - half) / 2;
+    prefetchElement(base + nextHalf);
+    prefetchElement(base + half + nextHalf);
+    bool notGreater = !std::invoke(compare, value,
+                                   std::invoke(projection, base[half]));
+    base = notGreater ? base + half : base;
+    length -= half;
+  }
+  return base + static_cast<std::ptrdiff_t>(!std::invoke(
+                    compare, value, std::invoke(projection, *base)));
+}
+
+// The subrange of elements equivalent to value, as [lowerBound, upperBound)
+template <std::random_access_iterator RandomIt, typename T,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::indirect_strict_weak_order<
+      Compare, const T *, std::projected<RandomIt, Projection>>
+std::pair<RandomIt, RandomIt> equalRange(RandomIt first, RandomIt last,
+                                         const T &value, Compare compare = {},
+                                         Projection projection = {}) {
+  RandomIt lower = lowerBound(first, last, value, compare, projection);
+  return {lower, upperBound(lower, last, value, compare, projection)};
+}
+
+template <std::ranges::random_access_range Range, typename T,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::ranges::borrowed_range<Range> &&
+           std::indirect_strict_weak_order<
+               Compare, const T *,
+               std::projected<std::ranges::iterator_t<Range>, Projection>>
+std::ranges::iterator_t<Range> lowerBound(Range &&range, const T &value,
+                                          Compare compare = {},
+                                          Projection projection = {}) {
+  return lowerBound(std::ranges::begin(range), std::ranges::end(range), value,
+                    std::move(compare), std::move(projection));
+}
+
+template <std::ranges::random_access_range Range, typename T,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::ranges::borrowed_range<Range> &&
+           std::indirect_strict_weak_order<
+               Compare, const T *,
+               std::projected<std::ranges::iterator_t<Range>, Projection>>
+std::ranges::iterator_t<Range> upperBound(Range &&range, const T &value,
+                                          Compare compare = {},
+                                          Projection projection = {}) {
+  return upperBound(std::ranges::begin(range), std::ranges::end(range), value,
+                    std::move(compare), std::move(projection));
+}
+
+template <std::ranges::random_access_range Range, typename T,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::ranges::borrowed_range<Range> &&
+           std::indirect_strict_weak_order<
+               Compare, const T *,
+               std::projected<std::ranges::iterator_t<Range>, Projection>>
+std::pair<std::ranges::iterator_t<Range>, std::ranges::iterator_t<Range>>
+equalRange(Range &&range, const T &value, Compare compare = {},
+           Projection projection = {}) {
+  return equalRange(std::ranges::begin(range), std::ranges::end(range), value,
+                    std::move(compare), std::move(projection));
+}
+
+#define BATCH_SEARCH_GROUP 16
+
+// Writes the lowerBound position in sortedRange of every query to out.
+// Sorted queries are answered by a merge-join that gallops forward from the
+// previous answer, so each search touches only the keys between two
+// neighbouring queries. Otherwise the queries are searched in groups of
+// BATCH_SEARCH_GROUP: all searches of a group take the same number of steps,
+// so they advance one level at a time and each prefetches its next probe
+// while the others compare, overlapping up to a group's worth of cache
+// misses instead of waiting for one per level.
+template <std::ranges::random_access_range Range,
+          std::ranges::forward_range Queries, std::weakly_incrementable Out,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::indirectly_writable<Out, size_t> &&
+           std::indirect_strict_weak_order<
+               Compare, const std::ranges::range_value_t<Queries> *,
+               std::projected<std::ranges::iterator_t<Range>, Projection>>
+Out batchLowerBound(Range &&sortedRange, Queries &&queries, Out out,
+                    Compare compare = {}, Projection projection = {}) {
+  auto first = std::ranges::begin(sortedRange);
+  auto size = static_cast<size_t>(std::ranges::distance(sortedRange));
+  auto less = [&](const auto &element, const auto &query) {
+    return std::invoke(compare, std::invoke(projection, element), query);
+  };
+
+  if (std::ranges::is_sorted(queries, compare)) {
+    size_t position = 0;
+    for (const auto &query : queries) {
+      size_t low = position;
+      size_t high = position;
+      for (size_t step = 1; high < size && less(first[high], query);
+           step *= 2) {
+        low = high + 1;
+        high = position + step;
+      }
+      high = std::min(high, size);
+      auto found = lowerBound(first + static_cast<std::ptrdiff_t>(low),
+                              first + static_cast<std::ptrdiff_t>(high),
+                              query, compare, projection);
+      position = static_cast<size_t>(found - first);
+      *out = position;
+      ++out;
+    }
+    return out;
+  }
+
+  auto query = std::ranges::begin(queries);
+  auto queriesEnd = std::ranges::end(queries);
+  std::ranges::iterator_t<Queries> pending[BATCH_SEARCH_GROUP];
+  std::ranges::iterator_t<Range> bases[BATCH_SEARCH_GROUP];
+  while (query != queriesEnd) {
+    size_t count = 0;
+    for (; count < BATCH_SEARCH_GROUP && query != queriesEnd;
+         ++count, ++query) {
+      pending[count] = query;
+      bases[count] = first;
+    }
+    if (size == 0) {
+      for (size_t i = 0; i < count; i++) {
+        *out = size_t(0);
+        ++out;
+      }
+      continue;
+    }
+    auto length = static_cast<std::ptrdiff_t>(size);
+    while (length > 1) {
+      auto half = length / 2;
+      auto nextHalf = (length - half) / 2;
+      for (size_t i = 0; i < count; i++) {
+        // a multiply rather than a select, which GCC turns into a branch
+        // once the bases live in memory
+        bases[i] += half * static_cast<std::ptrdiff_t>(
+                               less(bases[i][half], *pending[i]));
+        prefetchElement(bases[i] + nextHalf);
+      }
+      length -= half;
+    }
+    for (size_t i = 0; i < count; i++) {
+      *out = static_cast<size_t>(bases[i] - first) +
+             static_cast<size_t>(less(*bases[i], *pending[i]));
+      ++out;
+    }
+  }
+  return out;
+}
+
 template <typename T>
 std::optional<size_t> linearSearch(const std::vector<T> &array,
                                    const T &element) {
@@ -20,20 +243,18 @@ template <typename T>
 std::optional<size_t> binarySearch(const std::vector<T> &array,
                                    const T &element, size_t left,
                                    size_t rightIncl) {
-  if (left > rightIncl) {
+  // the recursive version stepped below index 0 for elements smaller than
+  // array[left]
+  if (left > rightIncl || rightIncl >= array.size()) {
     return {};
   }
-
-  size_t mid = left + (rightIncl - left) / 2;
-  if (array[mid] == element) {
-    return mid;
-  }
-
-  if (element < array[mid]) {
-    return binarySearch(array, element, left, mid - 1);
+  auto first = array.begin() + static_cast<std::ptrdiff_t>(left);
+  auto last = array.begin() + static_cast<std::ptrdiff_t>(rightIncl) + 1;
+  auto found = lowerBound(first, last, element);
+  if (found == last || element < *found) {
+    return {};
   }
-
-  return binarySearch(array, element, mid + 1, rightIncl);
+  return static_cast<size_t>(found - array.begin());
 }
 
 template <typename T>
@@ -65,34 +286,178 @@ std::optional<size_t> ternarySearch(const std::vector<T> &array,
   return ternarySearch(array, element, mid2 + 1, rightIncl);
 }
 
+// Scans the array in blocks of sqrt(size) keys, then linearly inside the
+// first block whose last key is not less than element
 template <typename T>
 std::optional<size_t> jumpSearch(const std::vector<T> &array,
                                  const T &element) {
-  size_t root = sqrt(array.size());
-  size_t step = root;
+  size_t step = std::max<size_t>(std::sqrt(array.size()), 1);
   size_t prev = 0;
-  while (array[step] < element) {
-    prev = step;
-    step += root;
-    if (prev >= array.size()) {
+  size_t next = step;
+  while (next < array.size() && array[next - 1] < element) {
+    prev = next;
+    next += step;
+  }
+  next = std::min(next, array.size());
+  for (size_t i = prev; i < next; i++) {
+    if (!(array[i] < element)) {
+      if (array[i] == element) {
+        return i;
+      }
       return {};
     }
   }
+  return {};
+}
 
-  step = std::min(step, array.size());
-
-  while (array[prev] < element) {
-    prev++;
-    if (prev == step) {
-      return {};
+// lowerBound for a key near the start of [first, last): probes 1, 2, 4, ...
+// keys ahead, then binary searches the last gap, taking O(log k) steps for
+// an answer k positions in. With std::unreachable_sentinel it searches
+// sequences without a known end, such as generated views, whose every
+// position can be read.
+template <std::random_access_iterator RandomIt,
+          std::sentinel_for<RandomIt> Sentinel, typename T,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::indirect_strict_weak_order<
+      Compare, const T *, std::projected<RandomIt, Projection>>
+RandomIt exponentialLowerBound(RandomIt first, Sentinel last, const T &value,
+                               Compare compare = {},
+                               Projection projection = {}) {
+  std::iter_difference_t<RandomIt> low = 0;
+  std::iter_difference_t<RandomIt> bound = 1;
+  while (true) {
+    if constexpr (std::sized_sentinel_for<Sentinel, RandomIt>) {
+      if (bound >= last - first) {
+        bound = last - first;
+        break;
+      }
+    }
+    if (!std::invoke(compare, std::invoke(projection, first[bound - 1]),
+                     value)) {
+      break;
     }
+    low = bound;
+    bound *= 2;
   }
+  return lowerBound(first + low, first + bound, value, compare, projection);
+}
 
-  if (array[step] == element) {
-    return step;
+// Finds element by galloping outwards from hint, so a key d positions
+// from the hint costs O(log d) comparisons
+template <typename T>
+std::optional<size_t> exponentialSearch(const std::vector<T> &array,
+                                        const T &element, size_t hint = 0) {
+  if (array.empty()) {
+    return {};
   }
+  hint = std::min(hint, array.size() - 1);
+  size_t found;
+  if (array[hint] < element) {
+    found = static_cast<size_t>(
+        exponentialLowerBound(array.begin() + static_cast<std::ptrdiff_t>(hint),
+                              array.end(), element) -
+        array.begin());
+  } else {
+    // array[high] is not less than element, array[high - step] is
+    size_t high = hint;
+    size_t step = 1;
+    while (step <= high && !(array[high - step] < element)) {
+      high -= step;
+      step *= 2;
+    }
+    size_t low = step <= high ? high - step + 1 : 0;
+    found = static_cast<size_t>(
+        lowerBound(array.begin() + static_cast<std::ptrdiff_t>(low),
+                   array.begin() + static_cast<std::ptrdiff_t>(high),
+                   element) -
+        array.begin());
+  }
+  if (found == array.size() || !(array[found] == element)) {
+    return {};
+  }
+  return found;
+}
 
-  return {};
+#define INTERPOLATION_SEARCH_CUTOFF 16
+#define INTERPOLATION_SEARCH_MISSES 1
+
+// Probes where element would sit if the keys between the ends of the range
+// were evenly spaced, along with a guard about 2 * sqrt(range) keys to
+// either side, fetched at the same time. On uniform keys the answer almost
+// always lies between the probe and a guard, so each step shrinks the range
+// to its square root and O(log log n) steps suffice. A step where it does
+// not is a miss; after INTERPOLATION_SEARCH_MISSES of them the distribution
+// is taken to defeat interpolation and the rest of the range is binary
+// searched, which bounds the worst case to O(log n).
+template <typename T>
+  requires std::is_arithmetic_v<T>
+std::optional<size_t> interpolationSearch(const std::vector<T> &array,
+                                          const T &element) {
+  if (array.empty() || element < array.front() || array.back() < element) {
+    return {};
+  }
+  // array[left] is less than element and array[right] is not, so the
+  // keys at both ends of the next interpolation are already known
+  size_t left = 0;
+  size_t right = array.size() - 1;
+  if (!(array[left] < element)) {
+    right = left;
+  }
+  T leftKey = array[left];
+  T rightKey = array[right];
+  size_t misses = 0;
+  while (right - left > INTERPOLATION_SEARCH_CUTOFF &&
+         misses < INTERPOLATION_SEARCH_MISSES) {
+    auto leftValue = static_cast<double>(leftKey);
+    double span = static_cast<double>(rightKey) - leftValue;
+    double fraction =
+        span > 0 ? (static_cast<double>(element) - leftValue) / span : 0.5;
+    // also catches the NaN of infinite keys
+    if (!(fraction >= 0)) {
+      fraction = 0;
+    }
+    fraction = std::min(fraction, 1.0);
+    size_t probe = left + 1 +
+                   static_cast<size_t>(fraction *
+                                       static_cast<double>(right - left - 2));
+    size_t guard = size_t(1) << (std::bit_width(right - left) / 2 + 1);
+    size_t below = probe - std::min(guard, probe - left - 1);
+    size_t above = probe + std::min(guard, right - 1 - probe);
+    prefetchElement(array.begin() + static_cast<std::ptrdiff_t>(below));
+    prefetchElement(array.begin() + static_cast<std::ptrdiff_t>(above));
+    if (array[probe] < element) {
+      left = probe;
+      leftKey = array[probe];
+      if (array[above] < element) {
+        left = above;
+        leftKey = array[above];
+        misses++;
+      } else {
+        right = above;
+        rightKey = array[above];
+      }
+    } else {
+      right = probe;
+      rightKey = array[probe];
+      if (array[below] < element) {
+        left = below;
+        leftKey = array[below];
+      } else {
+        right = below;
+        rightKey = array[below];
+        misses++;
+      }
+    }
+  }
+  auto found = static_cast<size_t>(
+      lowerBound(array.begin() + static_cast<std::ptrdiff_t>(left),
+                 array.begin() + static_cast<std::ptrdiff_t>(right), element) -
+      array.begin());
+  if (!(array[found] == element)) {
+    return {};
+  }
+  return found;
 }
 
 template <typename T>
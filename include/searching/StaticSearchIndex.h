@@ -0,0 +1,339 @@
+#ifndef STATIC_SEARCH_INDEX_H
+#define STATIC_SEARCH_INDEX_H
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SEARCH_INDEX_X86
+#include <immintrin.h>
+// only the node comparisons are compiled for AVX2; callers check
+// searchIndexHasAvx2() first
+#define SEARCH_INDEX_TARGET __attribute__((target("avx2")))
+#endif
+
+#define CACHE_LINE 64
+
+// EYTZINGER stores the keys in BFS order of a binary search tree, so the
+// next few levels of a search share a cache line and can be prefetched;
+// S_TREE is a static B+ tree with one cache line of keys per node
+enum class IndexLayout { EYTZINGER, S_TREE };
+
+// Key types whose S-tree nodes are compared with AVX2
+template <typename T>
+concept SimdSearchable =
+    std::same_as<T, int32_t> || std::same_as<T, uint32_t> ||
+    std::same_as<T, int64_t> || std::same_as<T, uint64_t> ||
+    std::same_as<T, float> || std::same_as<T, double>;
+
+inline bool searchIndexHasAvx2() {
+#ifdef SEARCH_INDEX_X86
+  static const bool SUPPORTED = __builtin_cpu_supports("avx2");
+  return SUPPORTED;
+#else
+  return false;
+#endif
+}
+
+// Allocates on cache line boundaries, so every S-tree node is one line
+template <typename T>
+struct CacheLineAllocator {
+  using value_type = T;
+
+  CacheLineAllocator() = default;
+  template <typename U>
+  CacheLineAllocator(const CacheLineAllocator<U> & /*other*/) {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(
+        ::operator new(count * sizeof(T), std::align_val_t(CACHE_LINE)));
+  }
+
+  void deallocate(T *pointer, size_t /*count*/) {
+    ::operator delete(pointer, std::align_val_t(CACHE_LINE));
+  }
+
+  friend bool operator==(const CacheLineAllocator & /*left*/,
+                         const CacheLineAllocator & /*right*/) {
+    return true;
+  }
+};
+
+// Read-only lower-bound index over sorted arithmetic keys. Both layouts are
+// built in O(n) and answer with the position in the original sorted
+// array, so results line up with the input.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+class StaticSearchIndex {
+ public:
+  // keys per S-tree node; a node has one child more
+  static constexpr size_t NODE_KEYS = CACHE_LINE / sizeof(T);
+
+ private:
+  IndexLayout layout;
+  size_t size = 0;
+  // EYTZINGER: keys[1..size] in BFS order; S_TREE: every layer, leaves
+  // first, padded to whole nodes
+  std::vector<T, CacheLineAllocator<T>> keys;
+  // S_TREE: the first key of every layer
+  std::vector<size_t> layerOffsets;
+
+  static constexpr T SENTINEL = std::numeric_limits<T>::has_infinity
+                                    ? std::numeric_limits<T>::infinity()
+                                    : std::numeric_limits<T>::max();
+
+  size_t fillEytzinger(const T *sorted, size_t next, size_t node);
+  size_t eytzingerRank(size_t node) const;
+  void buildSTree(const T *sorted);
+  size_t eytzingerLowerBound(const T &value) const;
+  size_t sTreeLowerBound(const T &value) const;
+#ifdef SEARCH_INDEX_X86
+  SEARCH_INDEX_TARGET size_t sTreeLowerBoundAvx2(const T &value) const
+    requires SimdSearchable<T>;
+#endif
+
+ public:
+  template <std::ranges::contiguous_range Range>
+    requires std::ranges::sized_range<Range> &&
+             std::same_as<std::ranges::range_value_t<Range>, T>
+  explicit StaticSearchIndex(const Range &sorted,
+                             IndexLayout layout = IndexLayout::S_TREE);
+  // Position of the first key not less than value, getSize() if none
+  [[nodiscard]] size_t lowerBound(const T &value) const;
+  [[nodiscard]] size_t getSize() const;
+  [[nodiscard]] IndexLayout getLayout() const;
+};
+
+template <typename T>
+  requires std::is_arithmetic_v<T>
+template <std::ranges::contiguous_range Range>
+  requires std::ranges::sized_range<Range> &&
+           std::same_as<std::ranges::range_value_t<Range>, T>
+StaticSearchIndex<T>::StaticSearchIndex(const Range &sorted,
+                                        IndexLayout layout)
+    : layout(layout), size(std::ranges::size(sorted)) {
+  if (!std::ranges::is_sorted(sorted)) {
+    throw std::invalid_argument("Index keys must be sorted");
+  }
+  const T *data = std::ranges::data(sorted);
+  if (layout == IndexLayout::EYTZINGER) {
+    this->keys.resize(this->size + 1);
+    fillEytzinger(data, 0, 1);
+  } else {
+    buildSTree(data);
+  }
+}
+
+// In-order walk of the implicit tree, where node k has children 2k and
+// 2k + 1, handing out the sorted keys in turn
+template <typename T>
+  requires std::is_arithmetic_v<T>
+size_t StaticSearchIndex<T>::fillEytzinger(const T *sorted, size_t next,
+                                           size_t node) {
+  if (node <= this->size) {
+    next = fillEytzinger(sorted, next, 2 * node);
+    this->keys[node] = sorted[next++];
+    next = fillEytzinger(sorted, next, 2 * node + 1);
+  }
+  return next;
+}
+
+// The leaves hold the sorted keys, so a leaf position is the answer. Key j
+// of an internal node is the first key under its child j + 1, which makes
+// the number of node keys below a value the child to descend into.
+// Missing children and padding get the largest value, which is never
+// below a probe.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+void StaticSearchIndex<T>::buildSTree(const T *sorted) {
+  std::vector<size_t> layerNodes = {
+      std::max<size_t>((this->size + NODE_KEYS - 1) / NODE_KEYS, 1)};
+  while (layerNodes.back() > 1) {
+    layerNodes.push_back((layerNodes.back() + NODE_KEYS) / (NODE_KEYS + 1));
+  }
+  size_t total = 0;
+  for (size_t nodes : layerNodes) {
+    this->layerOffsets.push_back(total);
+    total += nodes * NODE_KEYS;
+  }
+  this->keys.assign(total, SENTINEL);
+  std::copy(sorted, sorted + this->size, this->keys.begin());
+  // leaves under one node of the layer below the current one
+  size_t leavesPerChild = 1;
+  for (size_t layer = 1; layer < layerNodes.size(); layer++) {
+    T *layerKeys = this->keys.data() + this->layerOffsets[layer];
+    for (size_t node = 0; node < layerNodes[layer]; node++) {
+      for (size_t slot = 0; slot < NODE_KEYS; slot++) {
+        size_t child = node * (NODE_KEYS + 1) + slot + 1;
+        size_t first = child * leavesPerChild * NODE_KEYS;
+        if (first < this->size) {
+          layerKeys[node * NODE_KEYS + slot] = sorted[first];
+        }
+      }
+    }
+    leavesPerChild *= NODE_KEYS + 1;
+  }
+}
+
+// Sorted position of a node, so the index holds nothing but the keys. In a
+// perfect tree of height levels, node k at depth d is preceded in order by
+// (2(k - 2^d) + 1) 2^(height - 1 - d) - 1 nodes. Bottom level slots take
+// every even position of that order, and those past the filled ones are
+// missing from the real tree.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+size_t StaticSearchIndex<T>::eytzingerRank(size_t node) const {
+  size_t height = static_cast<size_t>(std::bit_width(this->size));
+  size_t depth = static_cast<size_t>(std::bit_width(node)) - 1;
+  size_t perfect =
+      ((2 * (node - (size_t(1) << depth)) + 1) << (height - 1 - depth)) - 1;
+  size_t bottomFilled = this->size - ((size_t(1) << (height - 1)) - 1);
+  size_t bottomBefore = (perfect + 1) / 2;
+  return perfect - (bottomBefore > bottomFilled ? bottomBefore - bottomFilled
+                                                : 0);
+}
+
+// Every step moves to child 2k or 2k + 1 without branching. The NODE_KEYS
+// descendants log2(NODE_KEYS) levels down share the cache line that
+// k * NODE_KEYS starts, which is fetched ahead. The answer is the last node
+// where the search turned left: stripping the trailing right turns, and
+// then that left turn, from k recovers it.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+size_t StaticSearchIndex<T>::eytzingerLowerBound(const T &value) const {
+  const T *tree = this->keys.data();
+  size_t node = 1;
+  while (node <= this->size) {
+#if defined(__GNUC__) || defined(__clang__)
+    // a prefetch past the end is harmless, so the address is formed
+    // without pointer arithmetic
+    __builtin_prefetch(reinterpret_cast<const void *>(
+        reinterpret_cast<uintptr_t>(tree) + node * NODE_KEYS * sizeof(T)));
+#endif
+    node = 2 * node + static_cast<size_t>(tree[node] < value);
+  }
+  node >>= std::countr_one(node) + 1;
+  return node == 0 ? this->size : eytzingerRank(node);
+}
+
+template <typename T>
+  requires std::is_arithmetic_v<T>
+size_t StaticSearchIndex<T>::sTreeLowerBound(const T &value) const {
+  auto rank = [&value](const T *node) {
+    size_t count = 0;
+    for (size_t slot = 0; slot < NODE_KEYS; slot++) {
+      count += static_cast<size_t>(node[slot] < value);
+    }
+    return count;
+  };
+  size_t node = 0;
+  for (size_t layer = this->layerOffsets.size() - 1; layer > 0; layer--) {
+    node = node * (NODE_KEYS + 1) +
+           rank(this->keys.data() + this->layerOffsets[layer] +
+                node * NODE_KEYS);
+  }
+  return std::min(node * NODE_KEYS + rank(this->keys.data() + node * NODE_KEYS),
+                  this->size);
+}
+
+#ifdef SEARCH_INDEX_X86
+// A node is two AVX2 registers. The lanes below the value are counted from
+// the comparison mask; unsigned keys and values get their top bit flipped
+// to fit the signed comparisons.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+SEARCH_INDEX_TARGET size_t
+StaticSearchIndex<T>::sTreeLowerBoundAvx2(const T &value) const
+  requires SimdSearchable<T>
+{
+  auto rank = [&value](const T *node) __attribute__((target("avx2"))) {
+    const auto *lanes = reinterpret_cast<const __m256i *>(node);
+    __m256i low = _mm256_load_si256(lanes);
+    __m256i high = _mm256_load_si256(lanes + 1);
+    unsigned mask;
+    if constexpr (std::floating_point<T> && sizeof(T) == 4) {
+      __m256 probe = _mm256_set1_ps(value);
+      mask = static_cast<unsigned>(
+          _mm256_movemask_ps(_mm256_cmp_ps(_mm256_castsi256_ps(low), probe,
+                                           _CMP_LT_OQ)) |
+          _mm256_movemask_ps(_mm256_cmp_ps(_mm256_castsi256_ps(high), probe,
+                                           _CMP_LT_OQ))
+              << 8);
+    } else if constexpr (std::floating_point<T>) {
+      __m256d probe = _mm256_set1_pd(value);
+      mask = static_cast<unsigned>(
+          _mm256_movemask_pd(_mm256_cmp_pd(_mm256_castsi256_pd(low), probe,
+                                           _CMP_LT_OQ)) |
+          _mm256_movemask_pd(_mm256_cmp_pd(_mm256_castsi256_pd(high), probe,
+                                           _CMP_LT_OQ))
+              << 4);
+    } else if constexpr (sizeof(T) == 4) {
+      __m256i flip = _mm256_set1_epi32(std::is_signed_v<T> ? 0 : INT32_MIN);
+      __m256i probe = _mm256_xor_si256(
+          _mm256_set1_epi32(static_cast<int32_t>(value)), flip);
+      low = _mm256_cmpgt_epi32(probe, _mm256_xor_si256(low, flip));
+      high = _mm256_cmpgt_epi32(probe, _mm256_xor_si256(high, flip));
+      mask = static_cast<unsigned>(
+          _mm256_movemask_ps(_mm256_castsi256_ps(low)) |
+          _mm256_movemask_ps(_mm256_castsi256_ps(high)) << 8);
+    } else {
+      __m256i flip = _mm256_set1_epi64x(std::is_signed_v<T> ? 0 : INT64_MIN);
+      __m256i probe = _mm256_xor_si256(
+          _mm256_set1_epi64x(static_cast<int64_t>(value)), flip);
+      low = _mm256_cmpgt_epi64(probe, _mm256_xor_si256(low, flip));
+      high = _mm256_cmpgt_epi64(probe, _mm256_xor_si256(high, flip));
+      mask = static_cast<unsigned>(
+          _mm256_movemask_pd(_mm256_castsi256_pd(low)) |
+          _mm256_movemask_pd(_mm256_castsi256_pd(high)) << 4);
+    }
+    return static_cast<size_t>(std::popcount(mask));
+  };
+  size_t node = 0;
+  for (size_t layer = this->layerOffsets.size() - 1; layer > 0; layer--) {
+    node = node * (NODE_KEYS + 1) +
+           rank(this->keys.data() + this->layerOffsets[layer] +
+                node * NODE_KEYS);
+  }
+  return std::min(node * NODE_KEYS + rank(this->keys.data() + node * NODE_KEYS),
+                  this->size);
+}
+#endif
+
+template <typename T>
+  requires std::is_arithmetic_v<T>
+size_t StaticSearchIndex<T>::lowerBound(const T &value) const {
+  if (this->layout == IndexLayout::EYTZINGER) {
+    return eytzingerLowerBound(value);
+  }
+#ifdef SEARCH_INDEX_X86
+  if constexpr (SimdSearchable<T>) {
+    if (searchIndexHasAvx2()) {
+      return sTreeLowerBoundAvx2(value);
+    }
+  }
+#endif
+  return sTreeLowerBound(value);
+}
+
+template <typename T>
+  requires std::is_arithmetic_v<T>
+size_t StaticSearchIndex<T>::getSize() const {
+  return this->size;
+}
+
+template <typename T>
+  requires std::is_arithmetic_v<T>
+IndexLayout StaticSearchIndex<T>::getLayout() const {
+  return this->layout;
+}
+
+#endif  // !STATIC_SEARCH_INDEX_H
@@ -0,0 +1,412 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Sorting.h"
+#include "ThreadPool.h"
+
+// smallest read or write issued per run during merging
+#define EXTERNAL_MIN_BLOCK (64 * 1024)
+
+struct ExternalSortOptions {
+  // bytes for the run buffers while generating runs and merging
+  size_t memoryBudget = size_t(256) << 20;
+  // most runs merged at once; memory may lower it further
+  size_t maxFanIn = 64;
+  std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+};
+
+struct ExternalSortStats {
+  size_t bytesRead = 0;
+  size_t bytesWritten = 0;
+  size_t runCount = 0;
+  size_t mergePasses = 0;
+};
+
+// Tournament tree over k sorted sources that keeps the loser of every match
+// in the inner nodes: replacing the winner replays a single leaf-to-root
+// path, log2(k) comparisons against a fixed set of opponents. Source i
+// provides its next element through current(i), nullptr once exhausted.
+template <typename T, typename Compare, typename Current>
+class LoserTree {
+ private:
+  std::vector<size_t> tree;
+  size_t k;
+  Compare &compare;
+  Current current;
+
+  // a leaf index of k stands for a key smaller than all others, it only
+  // exists while the tree is being built
+  bool beats(size_t left, size_t right) const;
+  void replay(size_t leaf);
+
+ public:
+  LoserTree(size_t k, Compare &compare, Current current);
+  // Source of the smallest current element, or k when all are exhausted
+  [[nodiscard]] size_t winner() const;
+  // Call after the winner's source moved on to its next element
+  void advanceWinner();
+};
+
+template <typename T, typename Compare, typename Current>
+LoserTree<T, Compare, Current>::LoserTree(size_t k, Compare &compare,
+                                          Current current)
+    : tree(std::max<size_t>(k, 1), k), k(k), compare(compare),
+      current(std::move(current)) {
+  for (size_t leaf = 0; leaf < k; leaf++) {
+    replay(leaf);
+  }
+}
+
+template <typename T, typename Compare, typename Current>
+bool LoserTree<T, Compare, Current>::beats(size_t left, size_t right) const {
+  if (left == this->k || right == this->k) {
+    return left == this->k;
+  }
+  const T *leftValue = this->current(left);
+  const T *rightValue = this->current(right);
+  if (leftValue == nullptr || rightValue == nullptr) {
+    return rightValue == nullptr && leftValue != nullptr;
+  }
+  // ties go to the lower source, which keeps equal records in run order
+  if (this->compare(*leftValue, *rightValue)) {
+    return true;
+  }
+  return !this->compare(*rightValue, *leftValue) && left < right;
+}
+
+template <typename T, typename Compare, typename Current>
+void LoserTree<T, Compare, Current>::replay(size_t leaf) {
+  size_t winner = leaf;
+  for (size_t node = (leaf + this->k) / 2; node > 0; node /= 2) {
+    if (beats(this->tree[node], winner)) {
+      std::swap(this->tree[node], winner);
+    }
+  }
+  this->tree[0] = winner;
+}
+
+template <typename T, typename Compare, typename Current>
+size_t LoserTree<T, Compare, Current>::winner() const {
+  size_t winner = this->tree[0];
+  if (winner == this->k || this->current(winner) == nullptr) {
+    return this->k;
+  }
+  return winner;
+}
+
+template <typename T, typename Compare, typename Current>
+void LoserTree<T, Compare, Current>::advanceWinner() {
+  replay(this->tree[0]);
+}
+
+// Reads a run file block by block. While one block is consumed the next one
+// is already being read on the I/O thread.
+template <typename T>
+class ExternalRunReader {
+ private:
+  std::ifstream stream;
+  std::vector<T> active;
+  std::vector<T> spare;
+  size_t position = 0;
+  size_t count = 0;
+  std::future<size_t> pending;
+  ThreadPool &io;
+  size_t &bytesRead;
+
+  void requestBlock();
+
+ public:
+  ExternalRunReader(const std::filesystem::path &path, size_t blockRecords,
+                    ThreadPool &io, size_t &bytesRead);
+  ExternalRunReader(const ExternalRunReader &other) = delete;
+  ExternalRunReader &operator=(const ExternalRunReader &other) = delete;
+  ~ExternalRunReader();
+  [[nodiscard]] const T *current() const;
+  void advance();
+};
+
+template <typename T>
+ExternalRunReader<T>::ExternalRunReader(const std::filesystem::path &path,
+                                        size_t blockRecords, ThreadPool &io,
+                                        size_t &bytesRead)
+    : stream(path, std::ios::binary),
+      active(blockRecords),
+      spare(blockRecords),
+      io(io),
+      bytesRead(bytesRead) {
+  if (!this->stream) {
+    throw std::runtime_error("Cannot open run " + path.string());
+  }
+  requestBlock();
+  advance();
+}
+
+template <typename T>
+ExternalRunReader<T>::~ExternalRunReader() {
+  // the I/O thread may still be filling spare
+  if (this->pending.valid()) {
+    this->pending.wait();
+  }
+}
+
+template <typename T>
+void ExternalRunReader<T>::requestBlock() {
+  auto promise = std::make_shared<std::promise<size_t>>();
+  this->pending = promise->get_future();
+  this->io.submit([this, promise] {
+    try {
+      this->stream.read(reinterpret_cast<char *>(this->spare.data()),
+                        static_cast<std::streamsize>(this->spare.size() *
+                                                     sizeof(T)));
+      if (this->stream.bad()) {
+        throw std::runtime_error("Cannot read run");
+      }
+      promise->set_value(static_cast<size_t>(this->stream.gcount()));
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  });
+}
+
+template <typename T>
+const T *ExternalRunReader<T>::current() const {
+  return this->position < this->count ? &this->active[this->position]
+                                      : nullptr;
+}
+
+template <typename T>
+void ExternalRunReader<T>::advance() {
+  if (++this->position < this->count || !this->pending.valid()) {
+    return;
+  }
+  size_t bytes = this->pending.get();
+  this->bytesRead += bytes;
+  std::swap(this->active, this->spare);
+  this->position = 0;
+  this->count = bytes / sizeof(T);
+  if (this->count == this->active.size()) {
+    requestBlock();
+  }
+}
+
+// Appends records to a file through a block-sized buffer
+template <typename T>
+class ExternalRunWriter {
+ private:
+  std::ofstream stream;
+  std::vector<T> buffer;
+  size_t count = 0;
+  size_t &bytesWritten;
+
+ public:
+  ExternalRunWriter(const std::filesystem::path &path, size_t blockRecords,
+                    size_t &bytesWritten);
+  void push(const T &value);
+  void write(const T *values, size_t size);
+  void flush();
+};
+
+template <typename T>
+ExternalRunWriter<T>::ExternalRunWriter(const std::filesystem::path &path,
+                                        size_t blockRecords,
+                                        size_t &bytesWritten)
+    : stream(path, std::ios::binary | std::ios::trunc),
+      buffer(blockRecords),
+      bytesWritten(bytesWritten) {
+  if (!this->stream) {
+    throw std::runtime_error("Cannot create " + path.string());
+  }
+}
+
+template <typename T>
+void ExternalRunWriter<T>::push(const T &value) {
+  this->buffer[this->count++] = value;
+  if (this->count == this->buffer.size()) {
+    flush();
+  }
+}
+
+template <typename T>
+void ExternalRunWriter<T>::write(const T *values, size_t size) {
+  flush();
+  this->stream.write(reinterpret_cast<const char *>(values),
+                     static_cast<std::streamsize>(size * sizeof(T)));
+  this->bytesWritten += size * sizeof(T);
+  if (!this->stream) {
+    throw std::runtime_error("Cannot write sorted records");
+  }
+}
+
+template <typename T>
+void ExternalRunWriter<T>::flush() {
+  if (this->count == 0) {
+    return;
+  }
+  size_t size = std::exchange(this->count, 0);
+  write(this->buffer.data(), size);
+}
+
+// Removes the temporary run files however the sort ends
+struct ExternalRunFiles {
+  std::filesystem::path directory;
+  std::string prefix;
+  size_t created = 0;
+  std::vector<std::filesystem::path> paths;
+
+  explicit ExternalRunFiles(std::filesystem::path directory)
+      : directory(std::move(directory)),
+        prefix("externalSort-" + std::to_string(std::random_device()()) + "-") {
+  }
+  ExternalRunFiles(const ExternalRunFiles &other) = delete;
+  ExternalRunFiles &operator=(const ExternalRunFiles &other) = delete;
+  ~ExternalRunFiles() {
+    std::error_code ignored;
+    for (const auto &path : this->paths) {
+      std::filesystem::remove(path, ignored);
+    }
+  }
+  std::filesystem::path create() {
+    this->paths.push_back(this->directory /
+                          (this->prefix + std::to_string(this->created++)));
+    return this->paths.back();
+  }
+};
+
+// Sorts a file of raw fixed-width records that need not fit in memory.
+// Sorted runs of half the memory budget are written to temporary files (the
+// other half holds the next run, read meanwhile on an I/O thread). Runs are
+// then merged through a loser tree, at most maxFanIn at a time, in as many
+// passes as it takes; every run reads ahead by one block.
+template <typename T, typename Compare = std::ranges::less>
+  requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+ExternalSortStats externalSort(const std::filesystem::path &input,
+                               const std::filesystem::path &output,
+                               Compare compare = {},
+                               const ExternalSortOptions &options = {}) {
+  ExternalSortStats stats;
+  ExternalRunFiles files(options.tempDirectory);
+  std::vector<std::filesystem::path> runs;
+
+  std::ifstream source(input, std::ios::binary);
+  if (!source) {
+    throw std::runtime_error("Cannot open " + input.string());
+  }
+  size_t runRecords =
+      std::max<size_t>(options.memoryBudget / (2 * sizeof(T)), 1);
+  std::vector<T> current(runRecords);
+  std::vector<T> next(runRecords);
+  // declared after every buffer its tasks touch, so it is joined first
+  ThreadPool io(1);
+  auto readRun = [&source, &io](std::vector<T> &buffer) {
+    auto promise = std::make_shared<std::promise<size_t>>();
+    std::future<size_t> bytes = promise->get_future();
+    char *data = reinterpret_cast<char *>(buffer.data());
+    auto size = static_cast<std::streamsize>(buffer.size() * sizeof(T));
+    io.submit([&source, data, size, promise] {
+      try {
+        source.read(data, size);
+        if (source.bad()) {
+          throw std::runtime_error("Cannot read input");
+        }
+        promise->set_value(static_cast<size_t>(source.gcount()));
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+    return bytes;
+  };
+  std::future<size_t> pending = readRun(current);
+  while (true) {
+    size_t bytes = pending.get();
+    if (bytes % sizeof(T) != 0) {
+      throw std::runtime_error("Input is not a whole number of records");
+    }
+    if (bytes == 0) {
+      break;
+    }
+    stats.bytesRead += bytes;
+    size_t records = bytes / sizeof(T);
+    bool last = records < runRecords;
+    if (!last) {
+      pending = readRun(next);
+    }
+    quickSort(current.begin(), current.begin() + records,
+              PartitionStrategy::BLOCK, compare);
+    // a single run is the result, no need to merge it
+    bool only = last && runs.empty();
+    runs.push_back(only ? output : files.create());
+    ExternalRunWriter<T>(runs.back(), 1, stats.bytesWritten)
+        .write(current.data(), records);
+    if (last) {
+      break;
+    }
+    std::swap(current, next);
+  }
+  stats.runCount = runs.size();
+  if (runs.empty()) {
+    ExternalRunWriter<T>(output, 1, stats.bytesWritten);
+    return stats;
+  }
+  current = std::vector<T>();
+  next = std::vector<T>();
+
+  // each run double-buffers its reads and the output needs one more block
+  size_t blocks = options.memoryBudget / EXTERNAL_MIN_BLOCK;
+  size_t fanIn = std::clamp<size_t>(blocks > 0 ? (blocks - 1) / 2 : 0, 2,
+                                    std::max<size_t>(options.maxFanIn, 2));
+  while (runs.size() > 1 || runs.front() != output) {
+    size_t width = std::min(fanIn, runs.size());
+    size_t blockRecords = std::max<size_t>(
+        options.memoryBudget / ((2 * width + 1) * sizeof(T)), 1);
+    std::vector<std::filesystem::path> merged;
+    for (size_t begin = 0; begin < runs.size(); begin += fanIn) {
+      size_t end = std::min(begin + fanIn, runs.size());
+      bool final = runs.size() <= fanIn;
+      merged.push_back(final ? output : files.create());
+      if (end - begin == 1 && !final) {
+        // a leftover run joins the next pass as it is
+        merged.back() = runs[begin];
+        continue;
+      }
+      std::vector<std::unique_ptr<ExternalRunReader<T>>> readers;
+      for (size_t run = begin; run < end; run++) {
+        readers.push_back(std::make_unique<ExternalRunReader<T>>(
+            runs[run], blockRecords, io, stats.bytesRead));
+      }
+      auto currentOf = [&readers](size_t run) {
+        return readers[run]->current();
+      };
+      LoserTree<T, Compare, decltype(currentOf)> tree(readers.size(), compare,
+                                                      currentOf);
+      ExternalRunWriter<T> writer(merged.back(), blockRecords,
+                                  stats.bytesWritten);
+      for (size_t winner = tree.winner(); winner < readers.size();
+           winner = tree.winner()) {
+        writer.push(*readers[winner]->current());
+        readers[winner]->advance();
+        tree.advanceWinner();
+      }
+      writer.flush();
+    }
+    runs = std::move(merged);
+    stats.mergePasses++;
+  }
+  return stats;
+}
+
+#endif  // !EXTERNAL_SORT_H
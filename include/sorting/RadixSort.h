@@ -0,0 +1,212 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Sorting.h"
+
+// below this size a string bucket is finished with insertion sort
+#define AMERICAN_FLAG_THRESHOLD 32
+
+template <typename T>
+concept RadixSortable =
+    (std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, float> ||
+    std::same_as<T, double>;
+
+// Maps a key to an unsigned integer with the same order. Signed integers get
+// their sign bit flipped; negative floats get all bits flipped and positive
+// ones the sign bit, so -0.0 sorts before 0.0 and NaNs end up at either end.
+template <RadixSortable T>
+auto radixKey(T value) {
+  if constexpr (std::floating_point<T>) {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr Bits SIGN = Bits(1) << (8 * sizeof(Bits) - 1);
+    Bits bits = std::bit_cast<Bits>(value);
+    return static_cast<Bits>((bits & SIGN) != 0 ? ~bits : bits | SIGN);
+  } else if constexpr (std::is_signed_v<T>) {
+    using Bits = std::make_unsigned_t<T>;
+    constexpr Bits SIGN = Bits(1) << (8 * sizeof(Bits) - 1);
+    return static_cast<Bits>(static_cast<Bits>(value) ^ SIGN);
+  } else {
+    return value;
+  }
+}
+
+// Stable LSD radix sort. Keys of 32 bits and more use 11-bit digits (three
+// passes for 32-bit keys), smaller keys 8-bit ones. All digit histograms are
+// built in one read of the input, and passes whose digit is the same for
+// every key are skipped.
+template <typename RandomIt, typename KeyExtractor>
+void lsdRadixSort(RandomIt first, RandomIt last, KeyExtractor key) {
+  using Value = typename std::iterator_traits<RandomIt>::value_type;
+  using Key = decltype(radixKey(std::invoke(key, *first)));
+  constexpr size_t DIGIT_BITS = sizeof(Key) >= 4 ? 11 : 8;
+  constexpr size_t PASSES = (8 * sizeof(Key) + DIGIT_BITS - 1) / DIGIT_BITS;
+  constexpr size_t BUCKETS = size_t(1) << DIGIT_BITS;
+  constexpr Key MASK = static_cast<Key>(BUCKETS - 1);
+
+  size_t size = static_cast<size_t>(last - first);
+  if (size < 2) {
+    return;
+  }
+  std::vector<std::array<size_t, BUCKETS>> counts(PASSES);
+  for (RandomIt it = first; it != last; ++it) {
+    Key bits = radixKey(std::invoke(key, *it));
+    for (size_t pass = 0; pass < PASSES; pass++) {
+      counts[pass][(bits >> (pass * DIGIT_BITS)) & MASK]++;
+    }
+  }
+
+  // raw storage: the first pass into it move-constructs, later ones assign
+  UninitializedBuffer<Value> buffer(size);
+  bool constructed = false;
+  bool inBuffer = false;
+  Key firstBits = radixKey(std::invoke(key, *first));
+  try {
+    for (size_t pass = 0; pass < PASSES; pass++) {
+      size_t shift = pass * DIGIT_BITS;
+      std::array<size_t, BUCKETS> &offsets = counts[pass];
+      if (offsets[(firstBits >> shift) & MASK] == size) {
+        continue;
+      }
+      size_t offset = 0;
+      for (size_t &count : offsets) {
+        offset += std::exchange(count, offset);
+      }
+      auto scatter = [&](auto source, auto destination) {
+        for (size_t i = 0; i < size; i++) {
+          Key bits = radixKey(std::invoke(key, source[i]));
+          destination[offsets[(bits >> shift) & MASK]++] =
+              std::move(source[i]);
+        }
+      };
+      if (inBuffer) {
+        scatter(buffer.data, first);
+      } else if (constructed) {
+        scatter(first, buffer.data);
+      } else {
+        // every bucket is filled from its start, so a throw leaves
+        // [start, offset) of each bucket to destroy
+        std::vector<size_t> starts(offsets.begin(), offsets.end());
+        try {
+          for (size_t i = 0; i < size; i++) {
+            Key bits = radixKey(std::invoke(key, first[i]));
+            std::construct_at(buffer.data + offsets[(bits >> shift) & MASK]++,
+                              std::move(first[i]));
+          }
+        } catch (...) {
+          for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+            std::destroy(buffer.data + starts[bucket],
+                         buffer.data + offsets[bucket]);
+          }
+          throw;
+        }
+        constructed = true;
+      }
+      inBuffer = !inBuffer;
+    }
+    if (inBuffer) {
+      std::move(buffer.data, buffer.data + size, first);
+    }
+  } catch (...) {
+    if (constructed) {
+      std::destroy_n(buffer.data, size);
+    }
+    throw;
+  }
+  if (constructed) {
+    std::destroy_n(buffer.data, size);
+  }
+}
+
+template <typename RandomIt>
+  requires RadixSortable<typename std::iterator_traits<RandomIt>::value_type>
+void radixSort(RandomIt first, RandomIt last) {
+  lsdRadixSort(first, last, std::identity());
+}
+
+// Sorts records by the integer or floating point field key returns
+template <typename RandomIt, typename KeyExtractor>
+  requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<
+      KeyExtractor &, typename std::iterator_traits<RandomIt>::reference>>>
+void radixSort(RandomIt first, RandomIt last, KeyExtractor key) {
+  lsdRadixSort(first, last, key);
+}
+
+// In-place MSD radix sort for strings. Each step counts the byte at the
+// current depth, swaps every string into its bucket along the permutation
+// cycles, and continues with the buckets one byte deeper. Buckets are kept
+// on an explicit stack, so long common prefixes cannot overflow the stack.
+template <typename RandomIt>
+void americanFlagSort(RandomIt first, RandomIt last) {
+  struct Bucket {
+    RandomIt first;
+    RandomIt last;
+    size_t depth;
+  };
+  // bucket 0 holds the strings that end before depth
+  auto byteAt = [](std::string_view string, size_t depth) -> size_t {
+    return depth < string.size()
+               ? static_cast<unsigned char>(string[depth]) + size_t(1)
+               : 0;
+  };
+
+  std::vector<Bucket> pending = {{first, last, 0}};
+  while (!pending.empty()) {
+    Bucket bucket = pending.back();
+    pending.pop_back();
+    size_t size = static_cast<size_t>(bucket.last - bucket.first);
+    size_t depth = bucket.depth;
+    if (size < AMERICAN_FLAG_THRESHOLD) {
+      // the strings share their first depth bytes, compare the rest only
+      insertionSort(bucket.first, bucket.last,
+                    [depth](std::string_view left, std::string_view right) {
+                      return left.substr(depth) < right.substr(depth);
+                    });
+      continue;
+    }
+
+    std::array<size_t, 257> counts{};
+    for (RandomIt it = bucket.first; it != bucket.last; ++it) {
+      counts[byteAt(*it, depth)]++;
+    }
+    std::array<size_t, 257> next{};
+    std::array<size_t, 257> ends{};
+    size_t offset = 0;
+    for (size_t digit = 0; digit < counts.size(); digit++) {
+      next[digit] = offset;
+      offset += counts[digit];
+      ends[digit] = offset;
+    }
+    for (size_t digit = 0; digit < counts.size(); digit++) {
+      while (next[digit] < ends[digit]) {
+        RandomIt current = bucket.first + next[digit];
+        size_t target = byteAt(*current, depth);
+        if (target == digit) {
+          next[digit]++;
+        } else {
+          std::iter_swap(current, bucket.first + next[target]++);
+        }
+      }
+    }
+    for (size_t digit = 1; digit < counts.size(); digit++) {
+      if (counts[digit] > 1) {
+        RandomIt end = bucket.first + ends[digit];
+        pending.push_back({end - counts[digit], end, depth + 1});
+      }
+    }
+  }
+}
+
+#endif  // !RADIX_SORT_H
@@ -2,8 +2,93 @@
 #define SORTING_H
 
 #include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "SortingNetworks.h"
+#include "ThreadPool.h"
+
+// below this size partitions are finished with insertion sort
+#define INTRO_SORT_THRESHOLD 16
+// the same for partitions a sorting network can finish
+#define NETWORK_SORT_THRESHOLD 128
+// from this size on the pivot is a ninther instead of a median of three
+#define NINTHER_THRESHOLD 128
+// ranges below this size are sorted and merged by a single task
+#define PARALLEL_GRAIN 8192
+// elements classified per batch by the block partition
+#define PARTITION_BLOCK 64
+// moves a partial insertion sort may make before it gives up
+#define PARTIAL_INSERTION_LIMIT 8
+// most buckets of a sample sort, so a bucket index fits a byte
+#define SAMPLE_SORT_BUCKETS 256
+// sample elements drawn per sample sort bucket
+#define SAMPLE_SORT_OVERSAMPLING 16
+// elements that descend the splitter tree side by side
+#define SAMPLE_SORT_UNROLL 8
+
+// How quickSort splits a range around its pivot: HOARE scans from both
+// ends, LOMUTO from one, and BLOCK classifies whole blocks without branches
+// and adds pdqsort's pattern and duplicate detection
+enum class PartitionStrategy { HOARE, LOMUTO, BLOCK };
+
+// Random-access ranges whose begin and end share a type, e.g. std::vector,
+// Vector, MappedVector, std::span or a plain array
+template <typename Range, typename Compare, typename Projection>
+concept SortableRange =
+    std::ranges::random_access_range<Range> &&
+    std::ranges::common_range<Range> &&
+    std::sortable<std::ranges::iterator_t<Range>, Compare, Projection>;
+
+// Ranges the sorting networks can sort: contiguous arithmetic elements in
+// their natural order
+template <typename RandomIt, typename Compare>
+concept NetworkSortableRange =
+    std::contiguous_iterator<RandomIt> &&
+    NetworkSortable<std::iter_value_t<RandomIt>> &&
+    (std::same_as<Compare, std::ranges::less> ||
+     std::same_as<Compare, std::less<>> ||
+     std::same_as<Compare, std::less<std::iter_value_t<RandomIt>>>);
+
+// Ranges the networks can sort without breaking stability: equal integers
+// cannot be told apart, but -0.0 and 0.0 compare equal and can
+template <typename RandomIt, typename Compare>
+concept StableNetworkSortableRange =
+    NetworkSortableRange<RandomIt, Compare> &&
+    std::integral<std::iter_value_t<RandomIt>>;
+
+template <typename RandomIt, typename Projection>
+using ProjectedKey =
+    std::remove_cvref_t<std::indirect_result_t<Projection &, RandomIt>>;
+
+// Folds the projection into the comparator, so the kernels take a single
+// callable; with std::identity it is the comparator itself, which lets the
+// kernels recognise the natural order
+template <typename Compare, typename Projection>
+auto projectedCompare(Compare &compare, Projection &projection) {
+  if constexpr (std::same_as<Projection, std::identity>) {
+    return compare;
+  } else {
+    return [&compare, &projection](auto &&left, auto &&right) -> bool {
+      return std::invoke(
+          compare, std::invoke(projection, std::forward<decltype(left)>(left)),
+          std::invoke(projection, std::forward<decltype(right)>(right)));
+    };
+  }
+}
+
 template <typename T>
 void bubbleSort(std::vector<T> &toBeSorted) {
   for (int i = 0; i < toBeSorted.size(); i++) {
@@ -15,6 +100,34 @@ void bubbleSort(std::vector<T> &toBeSorted) {
   }
 }
 
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void bubbleSort(RandomIt first, RandomIt last, Compare compare = {},
+                Projection projection = {}) {
+  auto less = projectedCompare(compare, projection);
+  // a pass without swaps means the rest is already in order
+  for (bool swapped = true; swapped && last - first > 1; --last) {
+    swapped = false;
+    for (RandomIt it = first; it + 1 != last; ++it) {
+      if (less(*(it + 1), *it)) {
+        std::iter_swap(it, it + 1);
+        swapped = true;
+      }
+    }
+  }
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void bubbleSort(Range &&range, Compare compare = {},
+                Projection projection = {}) {
+  bubbleSort(std::ranges::begin(range), std::ranges::end(range),
+             std::move(compare), std::move(projection));
+}
+
 template <typename T>
 void alternativeBubbleSort(std::vector<T> &toBeSorted) {
   for (int i = 0; i < toBeSorted.size(); i++) {
@@ -39,19 +152,96 @@ void selectionSort(std::vector<T> &array) {
   }
 }
 
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void selectionSort(RandomIt first, RandomIt last, Compare compare = {},
+                   Projection projection = {}) {
+  auto less = projectedCompare(compare, projection);
+  for (; first != last; ++first) {
+    RandomIt minimum = first;
+    for (RandomIt it = first + 1; it != last; ++it) {
+      if (less(*it, *minimum)) {
+        minimum = it;
+      }
+    }
+    std::iter_swap(first, minimum);
+  }
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void selectionSort(Range &&range, Compare compare = {},
+                   Projection projection = {}) {
+  selectionSort(std::ranges::begin(range), std::ranges::end(range),
+                std::move(compare), std::move(projection));
+}
+
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void insertionSort(RandomIt first, RandomIt last, Compare compare = {},
+                   Projection projection = {}) {
+  if (first == last) {
+    return;
+  }
+  auto less = projectedCompare(compare, projection);
+  for (RandomIt i = first + 1; i != last; ++i) {
+    auto unsorted = std::move(*i);
+    RandomIt j = i;
+    for (; j != first && less(unsorted, *(j - 1)); --j) {
+      *j = std::move(*(j - 1));
+    }
+    *j = std::move(unsorted);
+  }
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void insertionSort(Range &&range, Compare compare = {},
+                   Projection projection = {}) {
+  insertionSort(std::ranges::begin(range), std::ranges::end(range),
+                std::move(compare), std::move(projection));
+}
+
 template <typename T>
 void insertionSort(std::vector<T> &toBeSorted) {
-  for (size_t i = 1; i < toBeSorted.size(); i++) {
-    T unsorted = toBeSorted[i];
-    size_t j = i - 1;
-    while (toBeSorted[j] > unsorted && j >= 0) {
-      toBeSorted[j + 1] = toBeSorted[j];
-      j--;
+  // the index loop walked below 0 on a size_t, the iterator form cannot
+  insertionSort(toBeSorted.begin(), toBeSorted.end());
+}
+
+// Finishes a short range: with a sorting network when the range allows one
+// and the CPU has AVX2, otherwise with insertion sort. STABLE keeps the
+// networks to ranges where they are stable.
+template <bool STABLE = false, typename RandomIt, typename Compare>
+void smallSort(RandomIt first, RandomIt last, Compare &compare) {
+#ifdef SORTING_NETWORKS_X86
+  if constexpr (STABLE ? StableNetworkSortableRange<RandomIt, Compare>
+                       : NetworkSortableRange<RandomIt, Compare>) {
+    if (hasSortingNetworks() && last - first <= NETWORK_SORT_MAX) {
+      networkSortAvx2(std::to_address(first),
+                      static_cast<size_t>(last - first));
+      return;
+    }
+  }
+#endif
+  insertionSort(first, last, compare);
+}
+
+// Size up to which smallSort beats splitting the range further
+template <typename RandomIt, typename Compare, bool STABLE = false>
+std::ptrdiff_t smallSortThreshold() {
+  if constexpr (STABLE ? StableNetworkSortableRange<RandomIt, Compare>
+                       : NetworkSortableRange<RandomIt, Compare>) {
+    if (hasSortingNetworks()) {
+      return NETWORK_SORT_THRESHOLD;
     }
-    // in case the cycle isn't executed, j+1 should be equal to i
-    // in order to preserve the order,as it is correct
-    toBeSorted[j + 1] = unsorted;
   }
+  return INTRO_SORT_THRESHOLD;
 }
 
 template <typename T>
@@ -198,22 +388,1101 @@ void quickSort(std::vector<T> &array, size_t left, size_t right,
   quickSort(array, pivotIndex + 1, right);
 }
 
-void countingSort(std::vector<int> &array) {
-  std::vector<int> copy(array);
-  int max = *std::max_element(array.begin(), array.end());
-  std::vector<int> occurences(max + 1, 0);
-  for (auto &num : array) {
-    occurences[num]++;
+template <typename RandomIt, typename Compare>
+void siftDown(RandomIt first,
+              typename std::iterator_traits<RandomIt>::difference_type root,
+              typename std::iterator_traits<RandomIt>::difference_type size,
+              Compare &compare) {
+  auto value = std::move(first[root]);
+  while (true) {
+    auto child = 2 * root + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && compare(first[child], first[child + 1])) {
+      child++;
+    }
+    if (!compare(value, first[child])) {
+      break;
+    }
+    first[root] = std::move(first[child]);
+    root = child;
+  }
+  first[root] = std::move(value);
+}
+
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void heapSort(RandomIt first, RandomIt last, Compare compare = {},
+              Projection projection = {}) {
+  auto less = projectedCompare(compare, projection);
+  auto size = last - first;
+  for (auto root = size / 2 - 1; root >= 0; root--) {
+    siftDown(first, root, size, less);
+  }
+  for (auto end = size - 1; end > 0; end--) {
+    std::iter_swap(first, first + end);
+    siftDown(first, 0, end, less);
+  }
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void heapSort(Range &&range, Compare compare = {}, Projection projection = {}) {
+  heapSort(std::ranges::begin(range), std::ranges::end(range),
+           std::move(compare), std::move(projection));
+}
+
+template <typename RandomIt, typename Compare>
+RandomIt medianOfThree(RandomIt a, RandomIt b, RandomIt c, Compare &compare) {
+  if (compare(*a, *b)) {
+    if (compare(*b, *c)) {
+      return b;
+    }
+    return compare(*a, *c) ? c : a;
+  }
+  if (compare(*a, *c)) {
+    return a;
+  }
+  return compare(*b, *c) ? c : b;
+}
+
+// Moves a median-of-three (or ninther) pivot to the front of the range
+template <typename RandomIt, typename Compare>
+void choosePivot(RandomIt first, RandomIt last, Compare &compare) {
+  auto size = last - first;
+  RandomIt middle = first + size / 2;
+  RandomIt back = last - 1;
+  RandomIt median;
+  if (size >= NINTHER_THRESHOLD) {
+    auto step = size / 8;
+    median = medianOfThree(
+        medianOfThree(first, first + step, first + 2 * step, compare),
+        medianOfThree(middle - step, middle, middle + step, compare),
+        medianOfThree(back - 2 * step, back - step, back, compare), compare);
+  } else {
+    median = medianOfThree(first, middle, back, compare);
+  }
+  std::iter_swap(first, median);
+}
+
+// Hoare partition around the pivot at first. Returns the pivot's final
+// position; equal elements stop both scans, so runs of duplicates still
+// split in the middle.
+template <typename RandomIt, typename Compare>
+RandomIt partitionAroundFirst(RandomIt first, RandomIt last,
+                              Compare &compare) {
+  RandomIt i = first + 1;
+  RandomIt j = last - 1;
+  while (true) {
+    while (i <= j && compare(*i, *first)) {
+      ++i;
+    }
+    while (i <= j && compare(*first, *j)) {
+      --j;
+    }
+    if (i >= j) {
+      break;
+    }
+    std::iter_swap(i, j);
+    ++i;
+    --j;
+  }
+  std::iter_swap(first, j);
+  return j;
+}
+
+template <typename RandomIt, typename Compare>
+RandomIt hoarePartition(RandomIt first, RandomIt last, Compare &compare) {
+  choosePivot(first, last, compare);
+  return partitionAroundFirst(first, last, compare);
+}
+
+// Lomuto partition around the chosen pivot: a single scan that swaps every
+// smaller element to the front. Equal elements all end up on the right.
+template <typename RandomIt, typename Compare>
+RandomIt lomutoPartition(RandomIt first, RandomIt last, Compare &compare) {
+  choosePivot(first, last, compare);
+  RandomIt store = first + 1;
+  for (RandomIt it = first + 1; it != last; ++it) {
+    if (compare(*it, *first)) {
+      std::iter_swap(it, store++);
+    }
+  }
+  std::iter_swap(first, store - 1);
+  return store - 1;
+}
+
+template <PartitionStrategy STRATEGY = PartitionStrategy::HOARE,
+          typename RandomIt, typename Compare>
+void introSortLoop(RandomIt first, RandomIt last, size_t depthLimit,
+                   Compare &compare) {
+  auto threshold = smallSortThreshold<RandomIt, Compare>();
+  while (last - first > threshold) {
+    if (depthLimit == 0) {
+      heapSort(first, last, compare);
+      return;
+    }
+    depthLimit--;
+    RandomIt cut = STRATEGY == PartitionStrategy::LOMUTO
+                       ? lomutoPartition(first, last, compare)
+                       : hoarePartition(first, last, compare);
+    // recursing only into the smaller side bounds the stack by O(log n)
+    if (cut - first < last - cut) {
+      introSortLoop<STRATEGY>(first, cut, depthLimit, compare);
+      first = cut + 1;
+    } else {
+      introSortLoop<STRATEGY>(cut + 1, last, depthLimit, compare);
+      last = cut;
+    }
+  }
+  smallSort(first, last, compare);
+}
+
+// Quicksort that switches to heapsort once the recursion gets deeper than
+// 2 * log2(n), so the worst case stays O(n log n). Not stable.
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void introSort(RandomIt first, RandomIt last, Compare compare = {},
+               Projection projection = {}) {
+  auto size = static_cast<size_t>(last - first);
+  if (size < 2) {
+    return;
+  }
+  auto less = projectedCompare(compare, projection);
+  size_t depthLimit = 2 * static_cast<size_t>(std::bit_width(size) - 1);
+  introSortLoop(first, last, depthLimit, less);
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void introSort(Range &&range, Compare compare = {},
+               Projection projection = {}) {
+  introSort(std::ranges::begin(range), std::ranges::end(range),
+            std::move(compare), std::move(projection));
+}
+
+// Iterator form of quickSort; it is introsort, so sorted and reversed inputs
+// stay O(n log n)
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void quickSort(RandomIt first, RandomIt last, Compare compare = {},
+               Projection projection = {}) {
+  introSort(first, last, std::move(compare), std::move(projection));
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void quickSort(Range &&range, Compare compare = {},
+               Projection projection = {}) {
+  quickSort(std::ranges::begin(range), std::ranges::end(range),
+            std::move(compare), std::move(projection));
+}
+
+// Partition with the pivot at first: smaller elements go left, the others
+// right. Blocks from both ends are classified first, recording the offsets
+// of misplaced elements with branch-free increments, and the recorded
+// elements are then swapped in pairs, so the comparisons never feed a
+// branch. Also reports whether the range was partitioned already.
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, bool> blockPartition(RandomIt first, RandomIt last,
+                                         Compare &compare) {
+  RandomIt pivot = first;
+  RandomIt left = first + 1;
+  RandomIt right = last;
+  // [first + 1, left) holds smaller elements, [right, last) the others
+  while (left < right && compare(*left, *pivot)) {
+    ++left;
+  }
+  while (left < right && !compare(*(right - 1), *pivot)) {
+    --right;
+  }
+  bool alreadyPartitioned = left >= right;
+
+  unsigned char leftOffsets[PARTITION_BLOCK];
+  unsigned char rightOffsets[PARTITION_BLOCK];
+  size_t leftCount = 0;
+  size_t rightCount = 0;
+  size_t leftStart = 0;
+  size_t rightStart = 0;
+  while (right - left > 2 * PARTITION_BLOCK) {
+    if (leftCount == 0) {
+      leftStart = 0;
+      for (size_t i = 0; i < PARTITION_BLOCK; i++) {
+        leftOffsets[leftCount] = static_cast<unsigned char>(i);
+        leftCount += !compare(left[i], *pivot);
+      }
+    }
+    if (rightCount == 0) {
+      rightStart = 0;
+      for (size_t i = 0; i < PARTITION_BLOCK; i++) {
+        rightOffsets[rightCount] = static_cast<unsigned char>(i);
+        rightCount += compare(*(right - 1 - i), *pivot);
+      }
+    }
+    size_t swaps = std::min(leftCount, rightCount);
+    for (size_t i = 0; i < swaps; i++) {
+      std::iter_swap(left + leftOffsets[leftStart + i],
+                     right - 1 - rightOffsets[rightStart + i]);
+    }
+    leftCount -= swaps;
+    rightCount -= swaps;
+    leftStart += swaps;
+    rightStart += swaps;
+    if (leftCount == 0) {
+      left += PARTITION_BLOCK;
+    }
+    if (rightCount == 0) {
+      right -= PARTITION_BLOCK;
+    }
+  }
+  // the rest, including a half-finished block, is left to a plain scan
+  while (true) {
+    while (left < right && compare(*left, *pivot)) {
+      ++left;
+    }
+    while (left < right && !compare(*(right - 1), *pivot)) {
+      --right;
+    }
+    if (left >= right) {
+      break;
+    }
+    std::iter_swap(left++, --right);
+  }
+  std::iter_swap(pivot, left - 1);
+  return {left - 1, alreadyPartitioned};
+}
+
+// Used when the pivot equals the element before the range. Nothing in the
+// range is smaller then, so this splits it into elements equal to the pivot
+// (left) and greater ones (right), the three-way split for duplicates.
+template <typename RandomIt, typename Compare>
+RandomIt partitionEqual(RandomIt first, RandomIt last, Compare &compare) {
+  RandomIt i = first + 1;
+  RandomIt j = last - 1;
+  while (true) {
+    while (i <= j && !compare(*first, *i)) {
+      ++i;
+    }
+    while (i <= j && compare(*first, *j)) {
+      --j;
+    }
+    if (i >= j) {
+      break;
+    }
+    std::iter_swap(i, j);
+    ++i;
+    --j;
+  }
+  std::iter_swap(first, j);
+  return j;
+}
+
+// Insertion sort that gives up after PARTIAL_INSERTION_LIMIT moves, for
+// ranges that look sorted already. Returns whether it finished.
+template <typename RandomIt, typename Compare>
+bool partialInsertionSort(RandomIt first, RandomIt last, Compare &compare) {
+  if (first == last) {
+    return true;
+  }
+  size_t moves = 0;
+  for (RandomIt i = first + 1; i != last; ++i) {
+    if (!compare(*i, *(i - 1))) {
+      continue;
+    }
+    auto unsorted = std::move(*i);
+    RandomIt j = i;
+    do {
+      *j = std::move(*(j - 1));
+      --j;
+      moves++;
+    } while (j != first && compare(unsorted, *(j - 1)));
+    *j = std::move(unsorted);
+    if (moves > PARTIAL_INSERTION_LIMIT) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Swaps a few elements of a side that came out badly unbalanced, so inputs
+// built to defeat the pivot choice stop doing so
+template <typename RandomIt>
+void breakPatterns(RandomIt first, RandomIt last) {
+  auto size = last - first;
+  if (size >= INTRO_SORT_THRESHOLD) {
+    std::iter_swap(first, first + size / 4);
+    std::iter_swap(last - 1, last - size / 4);
+  }
+}
+
+// pdqsort: block partitioning; a partition that needed no swaps is finished
+// by partial insertion sorts, runs of duplicates are split off in one pass,
+// and log2(n) badly unbalanced partitions switch to heapsort
+template <typename RandomIt, typename Compare>
+void patternDefeatingLoop(RandomIt first, RandomIt last, size_t badAllowed,
+                          bool leftmost, Compare &compare) {
+  auto threshold = smallSortThreshold<RandomIt, Compare>();
+  while (last - first > threshold) {
+    auto size = last - first;
+    choosePivot(first, last, compare);
+    // the element before the range is a former pivot, no larger than any
+    // element of the range; a pivot equal to it means many duplicates
+    if (!leftmost && !compare(*(first - 1), *first)) {
+      first = partitionEqual(first, last, compare) + 1;
+      continue;
+    }
+    auto [cut, alreadyPartitioned] = blockPartition(first, last, compare);
+    auto leftSize = cut - first;
+    auto rightSize = last - cut - 1;
+    if (leftSize < size / 8 || rightSize < size / 8) {
+      if (--badAllowed == 0) {
+        heapSort(first, last, compare);
+        return;
+      }
+      breakPatterns(first, cut);
+      breakPatterns(cut + 1, last);
+    } else if (alreadyPartitioned &&
+               partialInsertionSort(first, cut, compare) &&
+               partialInsertionSort(cut + 1, last, compare)) {
+      return;
+    }
+    if (leftSize < rightSize) {
+      patternDefeatingLoop(first, cut, badAllowed, leftmost, compare);
+      first = cut + 1;
+      leftmost = false;
+    } else {
+      patternDefeatingLoop(cut + 1, last, badAllowed, false, compare);
+      last = cut;
+    }
+  }
+  smallSort(first, last, compare);
+}
+
+// Quicksort with a selectable partition scheme. Every strategy keeps the
+// O(n log n) worst case by falling back to heapsort.
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void quickSort(RandomIt first, RandomIt last, PartitionStrategy strategy,
+               Compare compare = {}, Projection projection = {}) {
+  auto size = static_cast<size_t>(last - first);
+  if (size < 2) {
+    return;
+  }
+  auto less = projectedCompare(compare, projection);
+  size_t logSize = static_cast<size_t>(std::bit_width(size) - 1);
+  switch (strategy) {
+    case PartitionStrategy::HOARE:
+      introSortLoop<PartitionStrategy::HOARE>(first, last, 2 * logSize, less);
+      break;
+    case PartitionStrategy::LOMUTO:
+      introSortLoop<PartitionStrategy::LOMUTO>(first, last, 2 * logSize,
+                                               less);
+      break;
+    case PartitionStrategy::BLOCK:
+      patternDefeatingLoop(first, last, std::max<size_t>(logSize, 1), true,
+                           less);
+      break;
+  }
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void quickSort(Range &&range, PartitionStrategy strategy, Compare compare = {},
+               Projection projection = {}) {
+  quickSort(std::ranges::begin(range), std::ranges::end(range), strategy,
+            std::move(compare), std::move(projection));
+}
+
+template <typename RandomIt, typename Compare>
+void introSelectLoop(RandomIt first, RandomIt nth, RandomIt last,
+                     size_t depthLimit, Compare &compare);
+
+// Pivot of the median-of-medians algorithm: the median of the medians of
+// groups of five, gathered at the front of the range. At least 3/10 of the
+// range lies on either side of it, which keeps selection O(n).
+template <typename RandomIt, typename Compare>
+RandomIt medianOfMedians(RandomIt first, RandomIt last, Compare &compare) {
+  RandomIt medians = first;
+  for (RandomIt group = first; last - group >= 5; group += 5) {
+    insertionSort(group, group + 5, compare);
+    std::iter_swap(medians++, group + 2);
+  }
+  if (medians == first) {
+    insertionSort(first, last, compare);
+    return first + (last - first) / 2;
+  }
+  RandomIt median = first + (medians - first) / 2;
+  introSelectLoop(first, median, medians, 0, compare);
+  return median;
+}
+
+// Quickselect that only follows the side holding nth. Once depthLimit
+// partitions are spent every pivot is a median of medians, so adversarial
+// input costs O(n) rather than O(n^2).
+template <typename RandomIt, typename Compare>
+void introSelectLoop(RandomIt first, RandomIt nth, RandomIt last,
+                     size_t depthLimit, Compare &compare) {
+  auto threshold = smallSortThreshold<RandomIt, Compare>();
+  while (last - first > threshold) {
+    if (depthLimit == 0) {
+      std::iter_swap(first, medianOfMedians(first, last, compare));
+    } else {
+      depthLimit--;
+      choosePivot(first, last, compare);
+    }
+    RandomIt cut = partitionAroundFirst(first, last, compare);
+    if (cut == nth) {
+      return;
+    }
+    if (nth < cut) {
+      last = cut;
+    } else {
+      first = cut + 1;
+    }
+  }
+  smallSort(first, last, compare);
+}
+
+// Puts the element that belongs at nth in sorted order there, with nothing
+// greater before it and nothing smaller after it. O(n) on average and in
+// the worst case.
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void nthElement(RandomIt first, RandomIt nth, RandomIt last,
+                Compare compare = {}, Projection projection = {}) {
+  auto size = static_cast<size_t>(last - first);
+  if (size < 2 || nth == last) {
+    return;
+  }
+  auto less = projectedCompare(compare, projection);
+  size_t depthLimit = 2 * static_cast<size_t>(std::bit_width(size) - 1);
+  introSelectLoop(first, nth, last, depthLimit, less);
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void nthElement(Range &&range, std::ranges::iterator_t<Range> nth,
+                Compare compare = {}, Projection projection = {}) {
+  nthElement(std::ranges::begin(range), nth, std::ranges::end(range),
+             std::move(compare), std::move(projection));
+}
+
+// Sorts the smallest middle - first elements into [first, middle) and
+// leaves the rest in [middle, last) in no particular order. Short prefixes
+// come from a max-heap that screens the rest in O(n log k) for
+// k = middle - first; long ones are selected with nthElement and sorted.
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void partialSort(RandomIt first, RandomIt middle, RandomIt last,
+                 Compare compare = {}, Projection projection = {}) {
+  auto heapSize = middle - first;
+  if (heapSize == 0) {
+    return;
+  }
+  auto less = projectedCompare(compare, projection);
+  if (heapSize > (last - first) / 8) {
+    auto size = static_cast<size_t>(last - first);
+    size_t depthLimit = 2 * static_cast<size_t>(std::bit_width(size) - 1);
+    if (middle != last) {
+      introSelectLoop(first, middle, last, depthLimit, less);
+    }
+    introSort(first, middle, less);
+    return;
+  }
+  for (auto root = heapSize / 2; root-- > 0;) {
+    siftDown(first, root, heapSize, less);
+  }
+  for (RandomIt it = middle; it != last; ++it) {
+    if (less(*it, *first)) {
+      std::iter_swap(it, first);
+      siftDown(first, 0, heapSize, less);
+    }
+  }
+  introSort(first, middle, less);
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void partialSort(Range &&range, std::ranges::iterator_t<Range> middle,
+                 Compare compare = {}, Projection projection = {}) {
+  partialSort(std::ranges::begin(range), middle, std::ranges::end(range),
+              std::move(compare), std::move(projection));
+}
+
+// The k smallest elements of range in sorted order; std::greater<>() gives
+// the k largest. A single pass keeps the best k seen so far in a max-heap,
+// so it takes O(n log k) time and O(k) memory and works on input ranges
+// that can be read only once.
+template <std::ranges::input_range Range,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::indirect_strict_weak_order<
+      Compare, std::projected<std::ranges::iterator_t<Range>, Projection>>
+std::vector<std::ranges::range_value_t<Range>> topK(
+    Range &&range, size_t k, Compare compare = {}, Projection projection = {}) {
+  std::vector<std::ranges::range_value_t<Range>> heap;
+  if (k == 0) {
+    return heap;
+  }
+  if constexpr (std::ranges::sized_range<Range>) {
+    heap.reserve(std::min(k, static_cast<size_t>(std::ranges::size(range))));
+  }
+  auto less = projectedCompare(compare, projection);
+  auto heapSize = static_cast<std::ptrdiff_t>(k);
+  for (auto &&element : range) {
+    if (heap.size() < k) {
+      heap.push_back(std::forward<decltype(element)>(element));
+      if (heap.size() == k) {
+        for (auto root = heapSize / 2; root-- > 0;) {
+          siftDown(heap.begin(), root, heapSize, less);
+        }
+      }
+    } else if (less(element, heap.front())) {
+      heap.front() = std::forward<decltype(element)>(element);
+      siftDown(heap.begin(), 0, heapSize, less);
+    }
+  }
+  introSort(heap.begin(), heap.end(), less);
+  return heap;
+}
+
+// Number of elements the first k outputs of a stable merge of left and right
+// take from left. Ties go to left, which keeps the merge stable.
+template <typename RandomIt, typename Compare>
+size_t coRank(size_t k, RandomIt left, size_t leftSize, RandomIt right,
+              size_t rightSize, Compare &compare) {
+  size_t low = k > rightSize ? k - rightSize : 0;
+  size_t high = std::min(k, leftSize);
+  while (low < high) {
+    size_t i = low + (high - low) / 2;
+    if (!compare(right[k - i - 1], left[i])) {
+      low = i + 1;
+    } else {
+      high = i;
+    }
+  }
+  return low;
+}
+
+// Stable merge. The network merge only takes integers, whose equal keys
+// cannot be told apart.
+template <typename InputIt, typename OutputIt, typename Compare>
+void mergeInto(InputIt left, InputIt leftEnd, InputIt right, InputIt rightEnd,
+               OutputIt output, Compare &compare) {
+#ifdef SORTING_NETWORKS_X86
+  if constexpr (StableNetworkSortableRange<InputIt, Compare> &&
+                std::contiguous_iterator<OutputIt> &&
+                std::same_as<std::iter_value_t<InputIt>,
+                             std::iter_value_t<OutputIt>>) {
+    if (hasSortingNetworks()) {
+      networkMergeAvx2(std::to_address(left),
+                       static_cast<size_t>(leftEnd - left),
+                       std::to_address(right),
+                       static_cast<size_t>(rightEnd - right),
+                       std::to_address(output));
+      return;
+    }
+  }
+#endif
+  while (left != leftEnd && right != rightEnd) {
+    if (compare(*right, *left)) {
+      *output++ = std::move(*right++);
+    } else {
+      *output++ = std::move(*left++);
+    }
+  }
+  output = std::move(left, leftEnd, output);
+  std::move(right, rightEnd, output);
+}
+
+// Merges the sorted halves [source, source + middle) and [source + middle,
+// source + size) into destination. Every task merges a slice of the output
+// whose inputs are found by co-ranking, so the slices are independent.
+template <typename RandomIt, typename OutputIt, typename Compare>
+void parallelMerge(RandomIt source, size_t middle, size_t size,
+                   OutputIt destination, Compare &compare, ThreadPool *pool) {
+  RandomIt right = source + middle;
+  size_t rightSize = size - middle;
+  if (pool == nullptr || size < 2 * PARALLEL_GRAIN) {
+    mergeInto(source, right, right, right + rightSize, destination, compare);
+    return;
+  }
+  size_t slices = std::min(size / PARALLEL_GRAIN, 4 * pool->getThreadCount());
+  TaskGroup group(*pool);
+  for (size_t slice = 0; slice < slices; slice++) {
+    group.run([=, &compare] {
+      size_t begin = size * slice / slices;
+      size_t end = size * (slice + 1) / slices;
+      size_t leftBegin = coRank(begin, source, middle, right, rightSize,
+                                compare);
+      size_t leftEnd = coRank(end, source, middle, right, rightSize, compare);
+      mergeInto(source + leftBegin, source + leftEnd,
+                right + (begin - leftBegin), right + (end - leftEnd),
+                destination + begin, compare);
+    });
+  }
+  group.wait();
+}
+
+// Sorts size elements into destination. source and destination start with
+// the same elements; each level sorts its halves into the other buffer and
+// merges them back, so one scratch copy serves the whole recursion.
+template <typename RandomIt, typename ScratchIt, typename Compare>
+void mergeSortInto(ScratchIt source, RandomIt destination, size_t size,
+                   Compare &compare, ThreadPool *pool) {
+  if (static_cast<std::ptrdiff_t>(size) <=
+      smallSortThreshold<RandomIt, Compare, true>()) {
+    smallSort<true>(destination, destination + size, compare);
+    return;
+  }
+  size_t middle = size / 2;
+  if (pool != nullptr && size > PARALLEL_GRAIN) {
+    TaskGroup group(*pool);
+    group.run([=, &compare] {
+      mergeSortInto(destination, source, middle, compare, pool);
+    });
+    mergeSortInto(destination + middle, source + middle, size - middle,
+                  compare, pool);
+    group.wait();
+  } else {
+    mergeSortInto(destination, source, middle, compare, pool);
+    mergeSortInto(destination + middle, source + middle, size - middle,
+                  compare, pool);
+  }
+  parallelMerge(source, middle, size, destination, compare, pool);
+}
+
+// Stable merge sort on a work-stealing pool of the given size. Both the
+// recursion and the merges run in parallel; the only allocation is a single
+// scratch copy of the input.
+template <typename RandomIt, typename Compare = std::less<>>
+void parallelMergeSort(RandomIt first, RandomIt last,
+                       Compare compare = Compare(),
+                       size_t threads = std::thread::hardware_concurrency()) {
+  size_t size = static_cast<size_t>(last - first);
+  if (size < 2) {
+    return;
+  }
+  using Value = typename std::iterator_traits<RandomIt>::value_type;
+  std::vector<Value> scratch(first, last);
+  if (threads <= 1 || size <= PARALLEL_GRAIN) {
+    mergeSortInto(scratch.begin(), first, size, compare, nullptr);
+    return;
+  }
+  // the calling thread helps while it waits, so it counts as one of them
+  ThreadPool pool(threads - 1);
+  mergeSortInto(scratch.begin(), first, size, compare, &pool);
+}
+
+// Lays the sorted splitters out as a complete binary search tree in BFS
+// order with the root at index 1, so node j has its children at 2j and
+// 2j + 1. Index 0 is unused.
+template <typename Value>
+std::vector<Value> buildSplitterTree(const std::vector<Value> &splitters) {
+  size_t bucketCount = splitters.size() + 1;
+  std::vector<Value> tree;
+  tree.reserve(bucketCount);
+  tree.push_back(splitters.front());
+  for (size_t level = 0; (size_t(1) << level) < bucketCount; level++) {
+    size_t stride = bucketCount >> (level + 1);
+    for (size_t node = 0; node < (size_t(1) << level); node++) {
+      tree.push_back(splitters[(2 * node + 1) * stride - 1]);
+    }
+  }
+  return tree;
+}
+
+// Bucket of every element of [first, first + size), where bucket b holds
+// the elements whose projection runs from splitter b - 1 up to, but
+// excluding, splitter b. Each tree level adds a comparison result to the
+// node index instead of branching on it, and SAMPLE_SORT_UNROLL elements
+// descend side by side so that their comparisons overlap.
+template <typename RandomIt, typename Value, typename Compare,
+          typename Projection = std::identity>
+void classifyBuckets(RandomIt first, size_t size,
+                     const std::vector<Value> &tree, uint8_t *buckets,
+                     Compare &compare, Projection projection = {}) {
+  size_t bucketCount = tree.size();
+  size_t i = 0;
+  for (; i + SAMPLE_SORT_UNROLL <= size; i += SAMPLE_SORT_UNROLL) {
+    size_t nodes[SAMPLE_SORT_UNROLL];
+    std::fill(nodes, nodes + SAMPLE_SORT_UNROLL, 1);
+    for (size_t level = 1; level < bucketCount; level *= 2) {
+      for (size_t u = 0; u < SAMPLE_SORT_UNROLL; u++) {
+        nodes[u] = 2 * nodes[u] +
+                   static_cast<size_t>(!compare(
+                       std::invoke(projection, first[i + u]), tree[nodes[u]]));
+      }
+    }
+    for (size_t u = 0; u < SAMPLE_SORT_UNROLL; u++) {
+      buckets[i + u] = static_cast<uint8_t>(nodes[u] - bucketCount);
+    }
+  }
+  for (; i < size; i++) {
+    size_t node = 1;
+    while (node < bucketCount) {
+      node = 2 * node + static_cast<size_t>(
+                            !compare(std::invoke(projection, first[i]),
+                                     tree[node]));
+    }
+    buckets[i] = static_cast<uint8_t>(node - bucketCount);
+  }
+}
+
+// Sample sort of the size elements at source into destination. The
+// splitters come from a sorted random sample SAMPLE_SORT_OVERSAMPLING times
+// larger than the bucket count. Every task classifies one stripe of source
+// and counts its buckets; the counts give each task its own write offset in
+// every bucket, so the scatter needs no synchronisation. The buckets are
+// then sorted independently, and bucketSorted(begin, end) runs in the task
+// that sorted a bucket. Compare orders the projections of the elements;
+// only projections are copied into the sample. With CONSTRUCT, destination
+// is uninitialized storage: the scatter move-constructs the elements there,
+// and a bucket is destroyed once bucketSorted returned or its sort threw.
+template <bool CONSTRUCT = false, typename SourceIt, typename RandomIt,
+          typename Compare, typename Projection, typename BucketSorted>
+void sampleSortInto(SourceIt source, RandomIt destination, size_t size,
+                    Compare &compare, Projection projection, ThreadPool &pool,
+                    BucketSorted &bucketSorted) {
+  using Value = typename std::iterator_traits<SourceIt>::value_type;
+  using Key = ProjectedKey<SourceIt, Projection>;
+  static_assert(!CONSTRUCT || std::is_nothrow_move_constructible_v<Value>,
+                "a throwing scatter would leave destination half built");
+  size_t bucketCount = std::clamp<size_t>(std::bit_ceil(size / PARALLEL_GRAIN),
+                                          2, SAMPLE_SORT_BUCKETS);
+  // 64-bit draws reach every element of inputs beyond 2^31 elements
+  std::mt19937_64 generator(size);
+  std::uniform_int_distribution<size_t> position(0, size - 1);
+  std::vector<Key> sample;
+  sample.reserve(SAMPLE_SORT_OVERSAMPLING * bucketCount);
+  for (size_t i = 0; i < SAMPLE_SORT_OVERSAMPLING * bucketCount; i++) {
+    sample.push_back(std::invoke(projection, source[position(generator)]));
+  }
+  introSort(sample.begin(), sample.end(), compare);
+  std::vector<Key> splitters;
+  splitters.reserve(bucketCount - 1);
+  for (size_t bucket = 1; bucket < bucketCount; bucket++) {
+    splitters.push_back(sample[bucket * SAMPLE_SORT_OVERSAMPLING]);
+  }
+  std::vector<Key> tree = buildSplitterTree(splitters);
+
+  size_t stripes = pool.getThreadCount() + 1;
+  std::vector<uint8_t> oracle(size);
+  std::vector<size_t> offsets(stripes * bucketCount);
+  TaskGroup group(pool);
+  for (size_t stripe = 0; stripe < stripes; stripe++) {
+    group.run([&, stripe] {
+      size_t begin = size * stripe / stripes;
+      size_t end = size * (stripe + 1) / stripes;
+      classifyBuckets(source + begin, end - begin, tree,
+                      oracle.data() + begin, compare, projection);
+      size_t *counts = offsets.data() + stripe * bucketCount;
+      for (size_t i = begin; i < end; i++) {
+        counts[oracle[i]]++;
+      }
+    });
+  }
+  group.wait();
+
+  // bucket by bucket, and within a bucket stripe by stripe
+  std::vector<size_t> bucketBegin(bucketCount + 1);
+  size_t offset = 0;
+  for (size_t bucket = 0; bucket < bucketCount; bucket++) {
+    bucketBegin[bucket] = offset;
+    for (size_t stripe = 0; stripe < stripes; stripe++) {
+      size_t count = offsets[stripe * bucketCount + bucket];
+      offsets[stripe * bucketCount + bucket] = offset;
+      offset += count;
+    }
+  }
+  bucketBegin[bucketCount] = size;
+
+  for (size_t stripe = 0; stripe < stripes; stripe++) {
+    group.run([&, stripe] {
+      size_t begin = size * stripe / stripes;
+      size_t end = size * (stripe + 1) / stripes;
+      size_t *next = offsets.data() + stripe * bucketCount;
+      for (size_t i = begin; i < end; i++) {
+        if constexpr (CONSTRUCT) {
+          std::construct_at(std::addressof(destination[next[oracle[i]]++]),
+                            std::move(source[i]));
+        } else {
+          destination[next[oracle[i]]++] = std::move(source[i]);
+        }
+      }
+    });
+  }
+  group.wait();
+
+  auto less = projectedCompare(compare, projection);
+  auto sortBucket = [&](size_t begin, size_t end) {
+    if (end - begin > 1) {
+      size_t logSize = static_cast<size_t>(std::bit_width(end - begin) - 1);
+      patternDefeatingLoop(destination + begin, destination + end, logSize,
+                           true, less);
+    }
+    bucketSorted(begin, end);
+  };
+  for (size_t bucket = 0; bucket < bucketCount; bucket++) {
+    group.run([&, bucket] {
+      size_t begin = bucketBegin[bucket];
+      size_t end = bucketBegin[bucket + 1];
+      if constexpr (CONSTRUCT) {
+        try {
+          sortBucket(begin, end);
+        } catch (...) {
+          std::destroy(destination + begin, destination + end);
+          throw;
+        }
+        std::destroy(destination + begin, destination + end);
+      } else {
+        sortBucket(begin, end);
+      }
+    });
+  }
+  group.wait();
+}
+
+// Uninitialized storage for size elements, freed without destroying them
+template <typename T>
+struct UninitializedBuffer {
+  T *data;
+  size_t size;
+
+  explicit UninitializedBuffer(size_t size)
+      : data(std::allocator<T>().allocate(size)), size(size) {}
+  UninitializedBuffer(const UninitializedBuffer &other) = delete;
+  UninitializedBuffer &operator=(const UninitializedBuffer &other) = delete;
+  ~UninitializedBuffer() {
+    std::allocator<T>().deallocate(this->data, this->size);
+  }
+};
+
+// Parallel sample sort on a work-stealing pool of the given size. Moving the
+// input aside, classification, scatter and the bucket sorts all run in
+// parallel, and the buckets are sorted with the block partition quicksort.
+// Not stable.
+template <typename RandomIt, typename Compare = std::less<>>
+void parallelSampleSort(RandomIt first, RandomIt last,
+                        Compare compare = Compare(),
+                        size_t threads = std::thread::hardware_concurrency()) {
+  size_t size = static_cast<size_t>(last - first);
+  if (threads <= 1 || size < 4 * PARALLEL_GRAIN) {
+    quickSort(first, last, PartitionStrategy::BLOCK, std::move(compare));
+    return;
+  }
+  using Value = typename std::iterator_traits<RandomIt>::value_type;
+  ThreadPool pool(threads - 1);
+  auto bucketSorted = [](size_t, size_t) {};
+  if constexpr (!std::is_nothrow_move_constructible_v<Value>) {
+    // a throwing move would leave other stripes' elements behind
+    std::vector<Value> scratch(std::make_move_iterator(first),
+                               std::make_move_iterator(last));
+    sampleSortInto(scratch.begin(), first, size, compare, std::identity(),
+                   pool, bucketSorted);
+  } else {
+    UninitializedBuffer<Value> scratch(size);
+    size_t stripes = pool.getThreadCount() + 1;
+    TaskGroup group(pool);
+    for (size_t stripe = 0; stripe < stripes; stripe++) {
+      group.run([&, stripe] {
+        size_t begin = size * stripe / stripes;
+        size_t end = size * (stripe + 1) / stripes;
+        std::uninitialized_move(first + begin, first + end,
+                                scratch.data + begin);
+      });
+    }
+    group.wait();
+    try {
+      sampleSortInto(scratch.data, first, size, compare, std::identity(),
+                     pool, bucketSorted);
+    } catch (...) {
+      std::destroy_n(scratch.data, size);
+      throw;
+    }
+    std::destroy_n(scratch.data, size);
+  }
+}
+
+// Sample sort of keys that carries values along: the value at
+// valuesFirst[i] belongs to the key at keysFirst[i] before and after. Keys
+// and values are moved into pairs, one stripe per task, scattered into
+// uninitialized storage and written back by the task that sorted their
+// bucket, so neither is ever copied or default-constructed.
+template <typename KeyIt, typename ValueIt, typename Compare = std::less<>>
+  requires std::is_nothrow_move_constructible_v<
+               typename std::iterator_traits<KeyIt>::value_type> &&
+           std::is_nothrow_move_constructible_v<
+               typename std::iterator_traits<ValueIt>::value_type>
+void parallelSampleSortByKey(
+    KeyIt keysFirst, KeyIt keysLast, ValueIt valuesFirst,
+    Compare compare = Compare(),
+    size_t threads = std::thread::hardware_concurrency()) {
+  using Key = typename std::iterator_traits<KeyIt>::value_type;
+  using Value = typename std::iterator_traits<ValueIt>::value_type;
+  using Entry = std::pair<Key, Value>;
+  size_t size = static_cast<size_t>(keysLast - keysFirst);
+  if (size < 2) {
+    return;
+  }
+  auto writeBack = [keysFirst, valuesFirst](Entry *sorted, size_t begin,
+                                            size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      keysFirst[i] = std::move(sorted[i].first);
+      valuesFirst[i] = std::move(sorted[i].second);
+    }
+  };
+  if (threads <= 1 || size < 4 * PARALLEL_GRAIN) {
+    std::vector<Entry> entries;
+    entries.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+      entries.emplace_back(std::move(keysFirst[i]), std::move(valuesFirst[i]));
+    }
+    auto byKey = [&compare](const Entry &left, const Entry &right) {
+      return compare(left.first, right.first);
+    };
+    quickSort(entries.begin(), entries.end(), PartitionStrategy::BLOCK,
+              byKey);
+    writeBack(entries.data(), 0, size);
+    return;
+  }
+  ThreadPool pool(threads - 1);
+  UninitializedBuffer<Entry> entries(size);
+  UninitializedBuffer<Entry> sorted(size);
+  {
+    size_t stripes = pool.getThreadCount() + 1;
+    TaskGroup group(pool);
+    for (size_t stripe = 0; stripe < stripes; stripe++) {
+      group.run([&, stripe] {
+        for (size_t i = size * stripe / stripes;
+             i < size * (stripe + 1) / stripes; i++) {
+          std::construct_at(entries.data + i, std::move(keysFirst[i]),
+                            std::move(valuesFirst[i]));
+        }
+      });
+    }
+    group.wait();
+  }
+  auto bucketSorted = [&](size_t begin, size_t end) {
+    writeBack(sorted.data, begin, end);
+  };
+  try {
+    sampleSortInto<true>(entries.data, sorted.data, size, compare,
+                         &Entry::first, pool, bucketSorted);
+  } catch (...) {
+    std::destroy_n(entries.data, size);
+    throw;
+  }
+  std::destroy_n(entries.data, size);
+}
+
+// Stable merge sort; the only allocation is one scratch copy of the input,
+// so the elements have to be copyable
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection> &&
+           std::copy_constructible<std::iter_value_t<RandomIt>>
+void mergeSort(RandomIt first, RandomIt last, Compare compare = {},
+               Projection projection = {}) {
+  size_t size = static_cast<size_t>(last - first);
+  if (size < 2) {
+    return;
   }
+  auto less = projectedCompare(compare, projection);
+  using Value = typename std::iterator_traits<RandomIt>::value_type;
+  std::vector<Value> scratch(first, last);
+  mergeSortInto(scratch.begin(), first, size, less, nullptr);
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection> &&
+           std::copy_constructible<std::ranges::range_value_t<Range>>
+void mergeSort(Range &&range, Compare compare = {},
+               Projection projection = {}) {
+  mergeSort(std::ranges::begin(range), std::ranges::end(range),
+            std::move(compare), std::move(projection));
+}
 
-  for (int i = 1; i <= max; i++) {
-    occurences[i] += occurences[i - 1];
+// Stable counting sort by an integral key. Memory is proportional to the
+// distance between the smallest and the largest key, negative keys included;
+// when that distance dwarfs the input it falls back to the stable merge sort,
+// which needs copyable elements.
+template <std::random_access_iterator RandomIt,
+          typename Projection = std::identity>
+  requires std::permutable<RandomIt> &&
+           std::copy_constructible<std::iter_value_t<RandomIt>> &&
+           std::integral<ProjectedKey<RandomIt, Projection>> &&
+           (!std::same_as<ProjectedKey<RandomIt, Projection>, bool>)
+void countingSort(RandomIt first, RandomIt last, Projection projection = {}) {
+  if (last - first < 2) {
+    return;
+  }
+  using Key = ProjectedKey<RandomIt, Projection>;
+  using Bits = std::make_unsigned_t<Key>;
+  using Value = typename std::iterator_traits<RandomIt>::value_type;
+  auto [minimum, maximum] = std::minmax_element(
+      first, last, [&projection](const auto &left, const auto &right) {
+        return std::invoke(projection, left) < std::invoke(projection, right);
+      });
+  Bits lowest = static_cast<Bits>(std::invoke(projection, *minimum));
+  Bits highest = static_cast<Bits>(std::invoke(projection, *maximum));
+  // unsigned arithmetic keeps the distance exact for signed keys too
+  constexpr size_t MIN_TABLE_SIZE = size_t{1} << 16;
+  size_t size = static_cast<size_t>(last - first);
+  Bits span = highest - lowest;
+  if (std::cmp_greater_equal(span, std::max(MIN_TABLE_SIZE, 4 * size))) {
+    mergeSort(first, last, std::ranges::less(), std::move(projection));
+    return;
   }
+  // narrow keys promote to int, cast back so the difference wraps as Bits
+  auto bucket = [&projection, lowest](const Value &value) {
+    return static_cast<size_t>(static_cast<Bits>(
+        static_cast<Bits>(std::invoke(projection, value)) - lowest));
+  };
 
-  for (auto i = copy.rbegin(); i != copy.rend(); ++i) {
-    array[occurences[*i] - 1] = *i;
-    occurences[*i]--;
+  std::vector<size_t> offsets(static_cast<size_t>(span) + 2, 0);
+  for (RandomIt it = first; it != last; ++it) {
+    offsets[bucket(*it) + 1]++;
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<Value> copy(std::make_move_iterator(first),
+                          std::make_move_iterator(last));
+  for (Value &value : copy) {
+    first[offsets[bucket(value)]++] = std::move(value);
   }
 }
 
+template <typename Range, typename Projection = std::identity>
+  requires std::ranges::random_access_range<Range> &&
+           std::ranges::common_range<Range>
+void countingSort(Range &&range, Projection projection = {}) {
+  countingSort(std::ranges::begin(range), std::ranges::end(range),
+               std::move(projection));
+}
+
+inline void countingSort(std::vector<int> &array) {
+  countingSort(array.begin(), array.end());
+}
+
 #endif  // SORTING_H
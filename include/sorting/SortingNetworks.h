@@ -0,0 +1,288 @@
+#ifndef SORTING_NETWORKS_H
+#define SORTING_NETWORKS_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SORTING_NETWORKS_X86
+#include <immintrin.h>
+#endif
+
+// largest block the networks sort in one go
+#define NETWORK_SORT_MAX 256
+
+// Element types the AVX2 networks handle, in their natural order. Inputs
+// must be free of NaNs, as they must be for std::less anyway.
+template <typename T>
+concept NetworkSortable =
+    std::same_as<T, int32_t> || std::same_as<T, int64_t> ||
+    std::same_as<T, float> || std::same_as<T, double>;
+
+inline bool hasSortingNetworks() {
+#ifdef SORTING_NETWORKS_X86
+  static const bool SUPPORTED = __builtin_cpu_supports("avx2");
+  return SUPPORTED;
+#else
+  return false;
+#endif
+}
+
+#ifdef SORTING_NETWORKS_X86
+// Only these functions are compiled for AVX2, so the header needs no global
+// -mavx2 and callers check hasSortingNetworks() before entering them
+#define NETWORK_TARGET __attribute__((target("avx2")))
+
+// Lane tables for one register of WIDTH elements, as 32-bit lanes for
+// _mm256_permutevar8x32_epi32 and full-lane blend masks; 64-bit elements
+// span two lanes. Indexed by log2 of the compare distance.
+template <size_t WIDTH>
+struct NetworkTables {
+  using Lanes = std::array<int32_t, 8>;
+  // lane of the partner at a distance
+  std::array<Lanes, 3> permutation{};
+  // lanes keeping the larger value in an ascending (upper) or descending
+  // (lower) merge step
+  std::array<Lanes, 3> upper{};
+  std::array<Lanes, 3> lower{};
+  // the same while sorting within a register, [log2 block][log2 distance]
+  std::array<std::array<Lanes, 3>, 3> sort{};
+  Lanes reverse{};
+};
+
+template <size_t WIDTH>
+constexpr NetworkTables<WIDTH> makeNetworkTables() {
+  constexpr size_t RATIO = 8 / WIDTH;
+  NetworkTables<WIDTH> tables;
+  for (size_t lane = 0; lane < 8; lane++) {
+    size_t element = lane / RATIO;
+    tables.reverse[lane] =
+        static_cast<int32_t>((WIDTH - 1 - element) * RATIO + lane % RATIO);
+    for (size_t bit = 0; (size_t(1) << bit) < WIDTH; bit++) {
+      size_t distance = size_t(1) << bit;
+      bool upperHalf = (element & distance) != 0;
+      tables.permutation[bit][lane] =
+          static_cast<int32_t>((element ^ distance) * RATIO + lane % RATIO);
+      tables.upper[bit][lane] = upperHalf ? -1 : 0;
+      tables.lower[bit][lane] = upperHalf ? 0 : -1;
+      for (size_t block = 1; (size_t(1) << block) < WIDTH; block++) {
+        bool ascending = (element & (size_t(1) << block)) == 0;
+        tables.sort[block][bit][lane] = ascending == upperHalf ? -1 : 0;
+      }
+    }
+  }
+  return tables;
+}
+
+template <NetworkSortable T>
+struct NetworkLanes {
+  static constexpr size_t WIDTH = 32 / sizeof(T);
+  static constexpr NetworkTables<WIDTH> TABLES = makeNetworkTables<WIDTH>();
+
+  NETWORK_TARGET static __m256i table(const std::array<int32_t, 8> &lanes) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.data()));
+  }
+
+  NETWORK_TARGET static __m256i load(const T *data) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  }
+
+  NETWORK_TARGET static void store(T *data, __m256i value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(data), value);
+  }
+
+  // all ones in the lanes where left < right
+  NETWORK_TARGET static __m256i less(__m256i left, __m256i right) {
+    if constexpr (std::same_as<T, int32_t>) {
+      return _mm256_cmpgt_epi32(right, left);
+    } else if constexpr (std::same_as<T, int64_t>) {
+      return _mm256_cmpgt_epi64(right, left);
+    } else if constexpr (std::same_as<T, float>) {
+      return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(left),
+                                               _mm256_castsi256_ps(right),
+                                               _CMP_LT_OQ));
+    } else {
+      return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(left),
+                                               _mm256_castsi256_pd(right),
+                                               _CMP_LT_OQ));
+    }
+  }
+
+  // Orders two registers lane by lane. Blending on a strict comparison
+  // keeps equal values (e.g. -0.0 and 0.0) instead of duplicating one.
+  NETWORK_TARGET static void compareExchange(__m256i &low, __m256i &high) {
+    __m256i swap = less(high, low);
+    __m256i smaller = _mm256_blendv_epi8(low, high, swap);
+    high = _mm256_blendv_epi8(high, low, swap);
+    low = smaller;
+  }
+
+  // Compares every lane with its partner; lanes set in keepsLarger take the
+  // larger value of the pair, the others the smaller one
+  NETWORK_TARGET static __m256i laneStep(__m256i value, __m256i permutation,
+                                         __m256i keepsLarger) {
+    __m256i partner = _mm256_permutevar8x32_epi32(value, permutation);
+    __m256i usePartner = _mm256_blendv_epi8(
+        less(partner, value), less(value, partner), keepsLarger);
+    return _mm256_blendv_epi8(value, partner, usePartner);
+  }
+
+  // Sorts a register that holds a bitonic sequence, ascending
+  NETWORK_TARGET static __m256i mergeLanes(__m256i value) {
+    for (size_t bit = std::countr_zero(WIDTH); bit-- > 0;) {
+      value = laneStep(value, table(TABLES.permutation[bit]),
+                       table(TABLES.upper[bit]));
+    }
+    return value;
+  }
+};
+
+// Bitonic sorting network over REGISTERS registers of WIDTH elements, with
+// element e in lane e % WIDTH of register e / WIDTH. Steps with a distance
+// of a register or more exchange whole registers, shorter ones permute lanes.
+template <NetworkSortable T, size_t REGISTERS>
+NETWORK_TARGET void bitonicSortRegisters(__m256i (&values)[REGISTERS]) {
+  using Lanes = NetworkLanes<T>;
+  constexpr size_t WIDTH = Lanes::WIDTH;
+  constexpr size_t SIZE = REGISTERS * WIDTH;
+  for (size_t block = 2; block <= SIZE; block *= 2) {
+    for (size_t distance = block / 2; distance > 0; distance /= 2) {
+      if (distance >= WIDTH) {
+        for (size_t r = 0; r < REGISTERS; r++) {
+          size_t partner = r ^ (distance / WIDTH);
+          if (partner < r) {
+            continue;
+          }
+          if (((r * WIDTH) & block) == 0) {
+            Lanes::compareExchange(values[r], values[partner]);
+          } else {
+            Lanes::compareExchange(values[partner], values[r]);
+          }
+        }
+        continue;
+      }
+      size_t bit = std::countr_zero(distance);
+      __m256i permutation = Lanes::table(Lanes::TABLES.permutation[bit]);
+      for (size_t r = 0; r < REGISTERS; r++) {
+        const auto &keepsLarger =
+            block < WIDTH ? Lanes::TABLES.sort[std::countr_zero(block)][bit]
+            : ((r * WIDTH) & block) == 0 ? Lanes::TABLES.upper[bit]
+                                         : Lanes::TABLES.lower[bit];
+        values[r] = Lanes::laneStep(values[r], permutation,
+                                    Lanes::table(keepsLarger));
+      }
+    }
+  }
+}
+
+template <NetworkSortable T, size_t REGISTERS>
+NETWORK_TARGET void networkSortBlock(T *data, size_t size) {
+  using Lanes = NetworkLanes<T>;
+  constexpr size_t SIZE = REGISTERS * Lanes::WIDTH;
+  // padding with the largest value keeps it behind the real elements
+  alignas(32) T buffer[SIZE];
+  std::copy(data, data + size, buffer);
+  std::fill(buffer + size, buffer + SIZE,
+            std::numeric_limits<T>::has_infinity
+                ? std::numeric_limits<T>::infinity()
+                : std::numeric_limits<T>::max());
+  __m256i values[REGISTERS];
+  for (size_t r = 0; r < REGISTERS; r++) {
+    values[r] = Lanes::load(buffer + r * Lanes::WIDTH);
+  }
+  bitonicSortRegisters<T, REGISTERS>(values);
+  for (size_t r = 0; r < REGISTERS; r++) {
+    Lanes::store(buffer + r * Lanes::WIDTH, values[r]);
+  }
+  std::copy(buffer, buffer + size, data);
+}
+
+// Sorts up to NETWORK_SORT_MAX elements with the smallest network that fits
+template <NetworkSortable T>
+NETWORK_TARGET void networkSortAvx2(T *data, size_t size) {
+  constexpr size_t WIDTH = NetworkLanes<T>::WIDTH;
+  size_t registers = std::bit_ceil(std::max(size, WIDTH)) / WIDTH;
+  switch (registers) {
+    case 1:
+      return networkSortBlock<T, 1>(data, size);
+    case 2:
+      return networkSortBlock<T, 2>(data, size);
+    case 4:
+      return networkSortBlock<T, 4>(data, size);
+    case 8:
+      return networkSortBlock<T, 8>(data, size);
+    case 16:
+      return networkSortBlock<T, 16>(data, size);
+    case 32:
+      return networkSortBlock<T, 32>(data, size);
+    default:
+      return networkSortBlock<T, NETWORK_SORT_MAX / WIDTH>(data, size);
+  }
+}
+
+// Merges two sorted arrays a register at a time: the two registers in
+// flight are merged by a bitonic network, the lower half is stored and the
+// upper half meets the next register from whichever input has the smaller
+// head. The tails shorter than a register are merged by scalar code.
+template <NetworkSortable T>
+NETWORK_TARGET void networkMergeAvx2(const T *left, size_t leftSize,
+                                     const T *right, size_t rightSize,
+                                     T *output) {
+  using Lanes = NetworkLanes<T>;
+  constexpr size_t WIDTH = Lanes::WIDTH;
+  const T *leftEnd = left + leftSize;
+  const T *rightEnd = right + rightSize;
+  if (leftSize >= WIDTH && rightSize >= WIDTH) {
+    __m256i reverse = Lanes::table(Lanes::TABLES.reverse);
+    __m256i low = Lanes::load(left);
+    __m256i high = Lanes::load(right);
+    left += WIDTH;
+    right += WIDTH;
+    while (true) {
+      high = _mm256_permutevar8x32_epi32(high, reverse);
+      Lanes::compareExchange(low, high);
+      Lanes::store(output, Lanes::mergeLanes(low));
+      output += WIDTH;
+      high = Lanes::mergeLanes(high);
+      bool takeLeft = static_cast<size_t>(leftEnd - left) >= WIDTH;
+      bool takeRight = static_cast<size_t>(rightEnd - right) >= WIDTH;
+      if (!takeLeft || !takeRight) {
+        break;
+      }
+      if (*right < *left) {
+        low = Lanes::load(right);
+        right += WIDTH;
+      } else {
+        low = Lanes::load(left);
+        left += WIDTH;
+      }
+    }
+    // the upper register still has to go: merge it into the shorter tail
+    alignas(32) T pending[WIDTH];
+    Lanes::store(pending, high);
+    T tail[2 * WIDTH];
+    bool leftShort = static_cast<size_t>(leftEnd - left) < WIDTH;
+    const T *shortBegin = leftShort ? left : right;
+    const T *shortEnd = leftShort ? leftEnd : rightEnd;
+    T *tailEnd = std::merge(pending, pending + WIDTH, shortBegin, shortEnd,
+                            tail);
+    if (leftShort) {
+      left = tail;
+      leftEnd = tailEnd;
+    } else {
+      right = tail;
+      rightEnd = tailEnd;
+    }
+    std::merge(left, leftEnd, right, rightEnd, output);
+    return;
+  }
+  std::merge(left, leftEnd, right, rightEnd, output);
+}
+#endif
+
+#endif  // !SORTING_NETWORKS_H
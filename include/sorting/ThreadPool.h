@@ -0,0 +1,234 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Work-stealing pool for fork-join parallelism. Every worker owns a deque:
+// it pushes and pops its own tasks at the back, idle workers steal from the
+// front of the others. Threads waiting on a TaskGroup keep running pending
+// tasks and only sleep while there is nothing to steal, so nested fork-join
+// neither deadlocks nor takes the waiting thread out of the pool.
+class ThreadPool {
+ private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::vector<std::thread> workers;
+  std::mutex sleepMutex;
+  std::condition_variable wakeUp;
+  std::condition_variable helperWakeUp;
+  size_t sleepingHelpers = 0;
+  std::atomic<size_t> queued = 0;
+  std::atomic<size_t> nextQueue = 0;
+  bool stopping = false;
+  inline static thread_local ThreadPool *currentPool = nullptr;
+  inline static thread_local size_t currentIndex = 0;
+
+  bool popTask(std::function<void()> &task);
+  void workerLoop(size_t index);
+
+ public:
+  explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+  ThreadPool(const ThreadPool &other) = delete;
+  ThreadPool &operator=(const ThreadPool &other) = delete;
+  ~ThreadPool();
+  void submit(std::function<void()> task);
+  // Runs one queued task on the calling thread, false if there was none
+  bool runPendingTask();
+  // Runs queued tasks on the calling thread until done() holds, sleeping
+  // while there is nothing to steal. Whoever makes done() true must call
+  // wakeHelpers afterwards.
+  template <typename Predicate>
+  void helpUntil(Predicate done);
+  void wakeHelpers();
+  [[nodiscard]] size_t getThreadCount() const;
+};
+
+// Tracks a batch of tasks; wait() helps the pool until all of them finished
+// and rethrows the first exception one of them threw
+class TaskGroup {
+ private:
+  ThreadPool &pool;
+  std::atomic<size_t> pending = 0;
+  std::mutex errorMutex;
+  std::exception_ptr error;
+
+ public:
+  explicit TaskGroup(ThreadPool &pool) : pool(pool) {}
+  TaskGroup(const TaskGroup &other) = delete;
+  TaskGroup &operator=(const TaskGroup &other) = delete;
+  ~TaskGroup();
+  template <typename Function>
+  void run(Function function);
+  void wait();
+};
+
+inline ThreadPool::ThreadPool(size_t threadCount) {
+  threadCount = std::max<size_t>(threadCount, 1);
+  for (size_t i = 0; i < threadCount; i++) {
+    this->queues.push_back(std::make_unique<WorkQueue>());
+  }
+  for (size_t i = 0; i < threadCount; i++) {
+    this->workers.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(this->sleepMutex);
+    this->stopping = true;
+  }
+  this->wakeUp.notify_all();
+  for (auto &worker : this->workers) {
+    worker.join();
+  }
+}
+
+inline bool ThreadPool::popTask(std::function<void()> &task) {
+  size_t count = this->queues.size();
+  bool isWorker = currentPool == this;
+  if (isWorker) {
+    WorkQueue &own = *this->queues[currentIndex];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      this->queued--;
+      return true;
+    }
+  }
+  size_t start = isWorker ? currentIndex + 1 : 0;
+  for (size_t offset = 0; offset < count; offset++) {
+    WorkQueue &victim = *this->queues[(start + offset) % count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      this->queued--;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void ThreadPool::workerLoop(size_t index) {
+  currentPool = this;
+  currentIndex = index;
+  while (true) {
+    if (runPendingTask()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(this->sleepMutex);
+    this->wakeUp.wait(
+        lock, [this] { return this->stopping || this->queued > 0; });
+    if (this->stopping && this->queued == 0) {
+      return;
+    }
+  }
+}
+
+inline void ThreadPool::submit(std::function<void()> task) {
+  size_t index = currentPool == this
+                     ? currentIndex
+                     : this->nextQueue++ % this->queues.size();
+  {
+    WorkQueue &queue = *this->queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  this->queued++;
+  bool helpersSleep = false;
+  {
+    // sleepers check queued under this lock, so the wake-up cannot be lost
+    std::lock_guard<std::mutex> lock(this->sleepMutex);
+    helpersSleep = this->sleepingHelpers > 0;
+  }
+  this->wakeUp.notify_one();
+  if (helpersSleep) {
+    this->helperWakeUp.notify_all();
+  }
+}
+
+inline bool ThreadPool::runPendingTask() {
+  std::function<void()> task;
+  if (!popTask(task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+template <typename Predicate>
+void ThreadPool::helpUntil(Predicate done) {
+  while (!done()) {
+    if (runPendingTask()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(this->sleepMutex);
+    this->sleepingHelpers++;
+    this->helperWakeUp.wait(
+        lock, [this, &done] { return done() || this->queued > 0; });
+    this->sleepingHelpers--;
+  }
+}
+
+inline void ThreadPool::wakeHelpers() {
+  {
+    // pairs with the predicate check in helpUntil, see submit
+    std::lock_guard<std::mutex> lock(this->sleepMutex);
+  }
+  this->helperWakeUp.notify_all();
+}
+
+inline size_t ThreadPool::getThreadCount() const {
+  return this->workers.size();
+}
+
+inline TaskGroup::~TaskGroup() {
+  // tasks still reference this group, never leave before they are done
+  this->pool.helpUntil([this] { return this->pending == 0; });
+}
+
+template <typename Function>
+void TaskGroup::run(Function function) {
+  this->pending++;
+  this->pool.submit([this, function = std::move(function)]() mutable {
+    try {
+      function();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(this->errorMutex);
+      if (!this->error) {
+        this->error = std::current_exception();
+      }
+    }
+    // the group may be gone once pending reaches zero, only the pool is
+    // touched afterwards
+    ThreadPool &pool = this->pool;
+    if (--this->pending == 0) {
+      pool.wakeHelpers();
+    }
+  });
+}
+
+inline void TaskGroup::wait() {
+  this->pool.helpUntil([this] { return this->pending == 0; });
+  if (this->error) {
+    std::exception_ptr error = std::exchange(this->error, nullptr);
+    std::rethrow_exception(error);
+  }
+}
+
+#endif  // !THREAD_POOL_H
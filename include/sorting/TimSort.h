@@ -0,0 +1,415 @@
+#ifndef TIM_SORT_H
+#define TIM_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "Sorting.h"
+
+// inputs below this size are a single binary insertion sort
+#define TIM_SORT_MIN_MERGE 32
+// winning streak after which a merge switches to galloping
+#define TIM_SORT_MIN_GALLOP 7
+
+// Length of the shortest run: n / minRun is a power of two or slightly less,
+// so the final merges stay balanced
+inline size_t timSortMinRun(size_t size) {
+  size_t lostBits = 0;
+  while (size >= TIM_SORT_MIN_MERGE) {
+    lostBits |= size & 1;
+    size >>= 1;
+  }
+  return size + lostBits;
+}
+
+// Length of the run starting at first. A strictly descending run is
+// reversed in place; strictly, so that reversing keeps the sort stable.
+template <typename RandomIt, typename Compare>
+size_t countRunAndMakeAscending(RandomIt first, RandomIt last,
+                                Compare &compare) {
+  RandomIt runEnd = first + 1;
+  if (runEnd == last) {
+    return 1;
+  }
+  if (compare(*runEnd++, *first)) {
+    while (runEnd != last && compare(*runEnd, *(runEnd - 1))) {
+      ++runEnd;
+    }
+    std::reverse(first, runEnd);
+  } else {
+    while (runEnd != last && !compare(*runEnd, *(runEnd - 1))) {
+      ++runEnd;
+    }
+  }
+  return static_cast<size_t>(runEnd - first);
+}
+
+// Sorts [first, last) given that [first, sortedEnd) is sorted already. Each
+// element's place is found by binary search after equal elements, which
+// keeps the sort stable and the comparisons at O(n log n).
+template <typename RandomIt, typename Compare>
+void binaryInsertionSort(RandomIt first, RandomIt sortedEnd, RandomIt last,
+                         Compare &compare) {
+  for (RandomIt it = sortedEnd; it != last; ++it) {
+    RandomIt position = std::upper_bound(first, it, *it, compare);
+    std::rotate(position, it, it + 1);
+  }
+}
+
+// Galloping searches: probe hint, hint +- 1, +- 3, +- 7, ... until the key is
+// bracketed, then binary search inside the bracket. The cost is logarithmic
+// in the distance from hint rather than in length.
+
+// Number of elements of [base, base + length) that are less than key
+template <typename RandomIt, typename T, typename Compare>
+size_t gallopLeft(const T &key, RandomIt base, size_t length, size_t hint,
+                  Compare &compare) {
+  std::ptrdiff_t lastOffset = 0;
+  std::ptrdiff_t offset = 1;
+  auto position = static_cast<std::ptrdiff_t>(hint);
+  if (compare(base[position], key)) {
+    auto maxOffset = static_cast<std::ptrdiff_t>(length) - position;
+    while (offset < maxOffset && compare(base[position + offset], key)) {
+      lastOffset = offset;
+      offset = 2 * offset + 1;
+    }
+    offset = std::min(offset, maxOffset);
+    lastOffset += position;
+    offset += position;
+  } else {
+    std::ptrdiff_t maxOffset = position + 1;
+    while (offset < maxOffset && !compare(base[position - offset], key)) {
+      lastOffset = offset;
+      offset = 2 * offset + 1;
+    }
+    offset = std::min(offset, maxOffset);
+    std::ptrdiff_t previous = lastOffset;
+    lastOffset = position - offset;
+    offset = position - previous;
+  }
+  // base[lastOffset] < key <= base[offset]
+  return static_cast<size_t>(
+      std::lower_bound(base + (lastOffset + 1), base + offset, key, compare) -
+      base);
+}
+
+// Number of elements of [base, base + length) that are not greater than key
+template <typename RandomIt, typename T, typename Compare>
+size_t gallopRight(const T &key, RandomIt base, size_t length, size_t hint,
+                   Compare &compare) {
+  std::ptrdiff_t lastOffset = 0;
+  std::ptrdiff_t offset = 1;
+  auto position = static_cast<std::ptrdiff_t>(hint);
+  if (compare(key, base[position])) {
+    std::ptrdiff_t maxOffset = position + 1;
+    while (offset < maxOffset && compare(key, base[position - offset])) {
+      lastOffset = offset;
+      offset = 2 * offset + 1;
+    }
+    offset = std::min(offset, maxOffset);
+    std::ptrdiff_t previous = lastOffset;
+    lastOffset = position - offset;
+    offset = position - previous;
+  } else {
+    auto maxOffset = static_cast<std::ptrdiff_t>(length) - position;
+    while (offset < maxOffset && !compare(key, base[position + offset])) {
+      lastOffset = offset;
+      offset = 2 * offset + 1;
+    }
+    offset = std::min(offset, maxOffset);
+    lastOffset += position;
+    offset += position;
+  }
+  // base[lastOffset] <= key < base[offset]
+  return static_cast<size_t>(
+      std::upper_bound(base + (lastOffset + 1), base + offset, key, compare) -
+      base);
+}
+
+// The pending runs of a TimSort and the merges between them. The stack keeps
+// every run longer than the two above it combined, so it stays O(log n)
+// deep and merges pair runs of similar length. The buffer only ever holds
+// the shorter run of a merge, at most half the input.
+template <typename RandomIt, typename Compare>
+class TimSortMerger {
+ private:
+  using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+  struct Run {
+    RandomIt base;
+    size_t length;
+  };
+
+  Compare &compare;
+  std::vector<Run> runs;
+  std::vector<Value> buffer;
+  std::ptrdiff_t minGallop = TIM_SORT_MIN_GALLOP;
+
+  void mergeAt(size_t index);
+  void mergeLow(RandomIt left, size_t leftSize, RandomIt right,
+                size_t rightSize);
+  void mergeHigh(RandomIt left, size_t leftSize, RandomIt right,
+                 size_t rightSize);
+
+ public:
+  explicit TimSortMerger(Compare &compare) : compare(compare) {}
+  void pushRun(RandomIt base, size_t length);
+  void mergeCollapse();
+  void mergeForceCollapse();
+};
+
+template <typename RandomIt, typename Compare>
+void TimSortMerger<RandomIt, Compare>::pushRun(RandomIt base, size_t length) {
+  this->runs.push_back({base, length});
+}
+
+// Restores the stack invariant, checking the top three runs and the one
+// below them, as a check of only the top three lets it break deeper down
+template <typename RandomIt, typename Compare>
+void TimSortMerger<RandomIt, Compare>::mergeCollapse() {
+  while (this->runs.size() > 1) {
+    size_t n = this->runs.size() - 2;
+    const auto &runs = this->runs;
+    if ((n > 0 &&
+         runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+        (n > 1 &&
+         runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+      if (runs[n - 1].length < runs[n + 1].length) {
+        n--;
+      }
+    } else if (runs[n].length > runs[n + 1].length) {
+      break;
+    }
+    mergeAt(n);
+  }
+}
+
+template <typename RandomIt, typename Compare>
+void TimSortMerger<RandomIt, Compare>::mergeForceCollapse() {
+  while (this->runs.size() > 1) {
+    size_t n = this->runs.size() - 2;
+    if (n > 0 && this->runs[n - 1].length < this->runs[n + 1].length) {
+      n--;
+    }
+    mergeAt(n);
+  }
+}
+
+// Merges runs index and index + 1. The prefix of the left run that is not
+// greater than the right run's first element and the suffix of the right
+// run that is not less than the left run's last element are in place
+// already and are skipped.
+template <typename RandomIt, typename Compare>
+void TimSortMerger<RandomIt, Compare>::mergeAt(size_t index) {
+  RandomIt left = this->runs[index].base;
+  size_t leftSize = this->runs[index].length;
+  RandomIt right = this->runs[index + 1].base;
+  size_t rightSize = this->runs[index + 1].length;
+  this->runs[index].length = leftSize + rightSize;
+  this->runs.erase(this->runs.begin() + static_cast<std::ptrdiff_t>(index) +
+                   1);
+
+  size_t skipped = gallopRight(*right, left, leftSize, 0, this->compare);
+  left += static_cast<std::ptrdiff_t>(skipped);
+  leftSize -= skipped;
+  if (leftSize == 0) {
+    return;
+  }
+  rightSize = gallopLeft(left[leftSize - 1], right, rightSize, rightSize - 1,
+                         this->compare);
+  if (rightSize == 0) {
+    return;
+  }
+  if (leftSize <= rightSize) {
+    mergeLow(left, leftSize, right, rightSize);
+  } else {
+    mergeHigh(left, leftSize, right, rightSize);
+  }
+}
+
+// Merges front to back with the left run moved to the buffer. Elements are
+// taken one at a time until one side wins TIM_SORT_MIN_GALLOP times in a
+// row; then both sides gallop until neither finds a long stretch. Galloping
+// that pays off lowers the threshold, galloping that does not raises it.
+template <typename RandomIt, typename Compare>
+void TimSortMerger<RandomIt, Compare>::mergeLow(RandomIt left,
+                                                size_t leftSize,
+                                                RandomIt right,
+                                                size_t rightSize) {
+  this->buffer.assign(std::make_move_iterator(left),
+                      std::make_move_iterator(left + leftSize));
+  auto cursorLeft = this->buffer.begin();
+  auto leftEnd = this->buffer.end();
+  RandomIt cursorRight = right;
+  RandomIt rightEnd = right + static_cast<std::ptrdiff_t>(rightSize);
+  RandomIt output = left;
+  std::ptrdiff_t minGallop = this->minGallop;
+  while (cursorLeft != leftEnd && cursorRight != rightEnd) {
+    std::ptrdiff_t leftWins = 0;
+    std::ptrdiff_t rightWins = 0;
+    while (cursorLeft != leftEnd && cursorRight != rightEnd &&
+           std::max(leftWins, rightWins) < minGallop) {
+      if (this->compare(*cursorRight, *cursorLeft)) {
+        *output++ = std::move(*cursorRight++);
+        rightWins++;
+        leftWins = 0;
+      } else {
+        *output++ = std::move(*cursorLeft++);
+        leftWins++;
+        rightWins = 0;
+      }
+    }
+    while (cursorLeft != leftEnd && cursorRight != rightEnd) {
+      leftWins = static_cast<std::ptrdiff_t>(
+          gallopRight(*cursorRight, cursorLeft,
+                      static_cast<size_t>(leftEnd - cursorLeft), 0,
+                      this->compare));
+      output = std::move(cursorLeft, cursorLeft + leftWins, output);
+      cursorLeft += leftWins;
+      if (cursorLeft == leftEnd) {
+        break;
+      }
+      *output++ = std::move(*cursorRight++);
+      if (cursorRight == rightEnd) {
+        break;
+      }
+      rightWins = static_cast<std::ptrdiff_t>(
+          gallopLeft(*cursorLeft, cursorRight,
+                     static_cast<size_t>(rightEnd - cursorRight), 0,
+                     this->compare));
+      output = std::move(cursorRight, cursorRight + rightWins, output);
+      cursorRight += rightWins;
+      if (cursorRight == rightEnd) {
+        break;
+      }
+      *output++ = std::move(*cursorLeft++);
+      minGallop--;
+      if (leftWins < TIM_SORT_MIN_GALLOP && rightWins < TIM_SORT_MIN_GALLOP) {
+        minGallop = std::max<std::ptrdiff_t>(minGallop, 0) + 2;
+        break;
+      }
+    }
+  }
+  this->minGallop = std::max<std::ptrdiff_t>(minGallop, 1);
+  // what is left of the right run is in place already
+  std::move(cursorLeft, leftEnd, output);
+}
+
+// The mirror image of mergeLow: the right run goes to the buffer and the
+// merge runs back to front
+template <typename RandomIt, typename Compare>
+void TimSortMerger<RandomIt, Compare>::mergeHigh(RandomIt left,
+                                                 size_t leftSize,
+                                                 RandomIt right,
+                                                 size_t rightSize) {
+  this->buffer.assign(std::make_move_iterator(right),
+                      std::make_move_iterator(right + rightSize));
+  auto rightBegin = this->buffer.begin();
+  auto cursorRight = this->buffer.end();
+  RandomIt cursorLeft = left + static_cast<std::ptrdiff_t>(leftSize);
+  RandomIt output = right + static_cast<std::ptrdiff_t>(rightSize);
+  std::ptrdiff_t minGallop = this->minGallop;
+  while (cursorLeft != left && cursorRight != rightBegin) {
+    std::ptrdiff_t leftWins = 0;
+    std::ptrdiff_t rightWins = 0;
+    while (cursorLeft != left && cursorRight != rightBegin &&
+           std::max(leftWins, rightWins) < minGallop) {
+      if (this->compare(*(cursorRight - 1), *(cursorLeft - 1))) {
+        *--output = std::move(*--cursorLeft);
+        leftWins++;
+        rightWins = 0;
+      } else {
+        *--output = std::move(*--cursorRight);
+        rightWins++;
+        leftWins = 0;
+      }
+    }
+    while (cursorLeft != left && cursorRight != rightBegin) {
+      auto remaining = static_cast<size_t>(cursorLeft - left);
+      leftWins = static_cast<std::ptrdiff_t>(
+          remaining - gallopRight(*(cursorRight - 1), left, remaining,
+                                  remaining - 1, this->compare));
+      output = std::move_backward(cursorLeft - leftWins, cursorLeft, output);
+      cursorLeft -= leftWins;
+      if (cursorLeft == left) {
+        break;
+      }
+      *--output = std::move(*--cursorRight);
+      if (cursorRight == rightBegin) {
+        break;
+      }
+      remaining = static_cast<size_t>(cursorRight - rightBegin);
+      rightWins = static_cast<std::ptrdiff_t>(
+          remaining - gallopLeft(*(cursorLeft - 1), rightBegin, remaining,
+                                 remaining - 1, this->compare));
+      output = std::move_backward(cursorRight - rightWins, cursorRight,
+                                  output);
+      cursorRight -= rightWins;
+      if (cursorRight == rightBegin) {
+        break;
+      }
+      *--output = std::move(*--cursorLeft);
+      minGallop--;
+      if (leftWins < TIM_SORT_MIN_GALLOP && rightWins < TIM_SORT_MIN_GALLOP) {
+        minGallop = std::max<std::ptrdiff_t>(minGallop, 0) + 2;
+        break;
+      }
+    }
+  }
+  this->minGallop = std::max<std::ptrdiff_t>(minGallop, 1);
+  // what is left of the left run is in place already
+  std::move_backward(rightBegin, cursorRight, output);
+}
+
+// Adaptive stable merge sort. Natural runs, ascending or strictly
+// descending, are found and extended to a minimum length by binary
+// insertion sort, then merged with galloping, so input made of a few sorted
+// stretches takes close to O(n) comparisons. The scratch buffer holds at
+// most n / 2 elements.
+template <std::random_access_iterator RandomIt,
+          typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires std::sortable<RandomIt, Compare, Projection>
+void timSort(RandomIt first, RandomIt last, Compare compare = {},
+             Projection projection = {}) {
+  auto size = static_cast<size_t>(last - first);
+  if (size < 2) {
+    return;
+  }
+  auto less = projectedCompare(compare, projection);
+  if (size < TIM_SORT_MIN_MERGE) {
+    size_t runLength = countRunAndMakeAscending(first, last, less);
+    binaryInsertionSort(first, first + runLength, last, less);
+    return;
+  }
+  TimSortMerger<RandomIt, decltype(less)> merger(less);
+  size_t minRun = timSortMinRun(size);
+  for (RandomIt runStart = first; runStart != last;) {
+    size_t runLength = countRunAndMakeAscending(runStart, last, less);
+    if (runLength < minRun) {
+      size_t forced = std::min(minRun, static_cast<size_t>(last - runStart));
+      binaryInsertionSort(runStart, runStart + runLength, runStart + forced,
+                          less);
+      runLength = forced;
+    }
+    merger.pushRun(runStart, runLength);
+    merger.mergeCollapse();
+    runStart += static_cast<std::ptrdiff_t>(runLength);
+  }
+  merger.mergeForceCollapse();
+}
+
+template <typename Range, typename Compare = std::ranges::less,
+          typename Projection = std::identity>
+  requires SortableRange<Range, Compare, Projection>
+void timSort(Range &&range, Compare compare = {}, Projection projection = {}) {
+  timSort(std::ranges::begin(range), std::ranges::end(range),
+          std::move(compare), std::move(projection));
+}
+
+#endif  // !TIM_SORT_H
@@ -2,11 +2,13 @@
 #ifndef AVL_TREE
 #define AVL_TREE
 
+#include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class AVLTree {
  public:
   struct Node {
@@ -15,8 +17,9 @@ class AVLTree {
     Node* right;
     unsigned short height = 1;
 
-    Node(const T& value, Node* left, Node* right)
-        : value(value), left(left), right(right) {
+    template <typename V>
+    Node(V&& value, Node* left, Node* right)
+        : value(std::forward<V>(value)), left(left), right(right) {
       this->height = 1 + std::max((left != nullptr ? left->height : 0),
                                   (right != nullptr ? right->height : 0));
     }
@@ -33,8 +36,19 @@ class AVLTree {
   };
 
  private:
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  static constexpr bool PROPAGATE_ON_MOVE =
+      NodeTraits::propagate_on_container_move_assignment::value;
+
+  [[no_unique_address]] NodeAllocator nodeAllocator;
   Node* root = nullptr;
+  template <typename V>
+  Node* createNode(V&& value, Node* left, Node* right);
+  void destroyNode(Node* node);
   Node* copy(Node* other);
+  Node* moveValues(Node* other);
   void freeNode(Node* node);
   void free();
   Node* insert(Node* parent, const T& value);
@@ -47,51 +61,86 @@ class AVLTree {
 
  public:
   AVLTree();
-  AVLTree(const AVLTree<T>& other);
-  AVLTree& operator=(const AVLTree<T>& other);
-  AVLTree(AVLTree<T>&& other) noexcept;
-  AVLTree& operator=(AVLTree<T>&& other) noexcept;
+  explicit AVLTree(const Allocator& allocator);
+  AVLTree(const AVLTree<T, Allocator>& other);
+  AVLTree& operator=(const AVLTree<T, Allocator>& other);
+  AVLTree(AVLTree<T, Allocator>&& other) noexcept;
+  AVLTree& operator=(AVLTree<T, Allocator>&& other) noexcept(
+      PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value);
   ~AVLTree();
+  [[nodiscard]] Allocator getAllocator() const;
   void insert(const T& element);
   void remove(const T& element);
   std::vector<T> getElements() const;
   [[nodiscard]] bool isBalanced() const;
 
-  template <typename S>
+  template <typename S, typename A>
   friend std::ostream& operator<<(std::ostream& outputStream,
-                                  const AVLTree<S>& tree);
+                                  const AVLTree<S, A>& tree);
 };
 
-template <typename T>
-AVLTree<T>::Node* AVLTree<T>::copy(Node* other) {
+template <typename T, typename Allocator>
+template <typename V>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::createNode(
+    V&& value, Node* left, Node* right) {
+  Node* node = NodeTraits::allocate(this->nodeAllocator, 1);
+  try {
+    NodeTraits::construct(this->nodeAllocator, node, std::forward<V>(value),
+                          left, right);
+  } catch (...) {
+    NodeTraits::deallocate(this->nodeAllocator, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::destroyNode(Node* node) {
+  NodeTraits::destroy(this->nodeAllocator, node);
+  NodeTraits::deallocate(this->nodeAllocator, node, 1);
+}
+
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::copy(Node* other) {
   if (other == nullptr) {
     return nullptr;
   }
-  Node* root = new Node(other->value, nullptr, nullptr);
+  Node* root = createNode(other->value, nullptr, nullptr);
   root->left = copy(other->left);
   root->right = copy(other->right);
   return root;
 }
 
-template <typename T>
-void AVLTree<T>::freeNode(Node* node) {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::moveValues(Node* other) {
+  if (other == nullptr) {
+    return nullptr;
+  }
+  Node* left = moveValues(other->left);
+  Node* right = moveValues(other->right);
+  return createNode(std::move(other->value), left, right);
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::freeNode(Node* node) {
   if (node == nullptr) {
     return;
   }
   freeNode(node->left);
   freeNode(node->right);
-  delete node;
+  destroyNode(node);
 }
 
-template <typename T>
-void AVLTree<T>::free() {
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::free() {
   freeNode(this->root);
 }
 
-template <typename T>
-AVLTree<T>::Node* AVLTree<T>::insert(Node* parent, const T& value) {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::insert(
+    Node* parent, const T& value) {
   if (parent == nullptr) {
-    return new Node(value, nullptr, nullptr);
+    return createNode(value, nullptr, nullptr);
   }
   if (value < parent->value) {
     parent->left = insert(parent->left, value);
@@ -117,20 +166,21 @@ AVLTree<T>::Node* AVLTree<T>::insert(Node* parent, const T& value) {
   return parent;
 }
 
-template <typename T>
-AVLTree<T>::Node* AVLTree<T>::remove(Node* parent, const T& value) {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::remove(
+    Node* parent, const T& value) {
   if (parent == nullptr) {
     return nullptr;
   }
   if (value == parent->value) {
     if (parent->left == nullptr) {
       Node* temp = parent->right;
-      delete parent;
+      destroyNode(parent);
       return temp;
     }
     if (parent->right == nullptr) {
       Node* temp = parent->left;
-      delete parent;
+      destroyNode(parent);
       return temp;
     }
     Node* smallestInRightTree = smallestValueNode(parent->right);
@@ -165,8 +215,9 @@ AVLTree<T>::Node* AVLTree<T>::remove(Node* parent, const T& value) {
   return parent;
 }
 
-template <typename T>
-AVLTree<T>::Node* AVLTree<T>::smallestValueNode(Node* root) {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::smallestValueNode(
+    Node* root) {
   if (root == nullptr) {
     return root;
   }
@@ -177,8 +228,8 @@ AVLTree<T>::Node* AVLTree<T>::smallestValueNode(Node* root) {
   return smallestValueNode;
 }
 
-template <typename T>
-AVLTree<T>::Node* AVLTree<T>::rotateRight(Node* oldRoot) {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::rotateRight(Node* oldRoot) {
   Node* newRoot = oldRoot->left;
   oldRoot->left = newRoot->right;
   newRoot->right = oldRoot;
@@ -191,8 +242,8 @@ AVLTree<T>::Node* AVLTree<T>::rotateRight(Node* oldRoot) {
   return newRoot;
 }
 
-template <typename T>
-AVLTree<T>::Node* AVLTree<T>::rotateLeft(Node* oldRoot) {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::Node* AVLTree<T, Allocator>::rotateLeft(Node* oldRoot) {
   Node* newRoot = oldRoot->right;
   oldRoot->right = newRoot->left;
   newRoot->left = oldRoot;
@@ -205,8 +256,8 @@ AVLTree<T>::Node* AVLTree<T>::rotateLeft(Node* oldRoot) {
   return newRoot;
 }
 
-template <typename T>
-std::string AVLTree<T>::print(Node* node, unsigned int level) const {
+template <typename T, typename Allocator>
+std::string AVLTree<T, Allocator>::print(Node* node, unsigned int level) const {
   std::string output;
   if (node != nullptr) {
     output = std::string("\t", level) + std::to_string(node->value);
@@ -220,8 +271,8 @@ std::string AVLTree<T>::print(Node* node, unsigned int level) const {
   return output;
 }
 
-template <typename T>
-std::vector<T> AVLTree<T>::getElements(Node* node) const {
+template <typename T, typename Allocator>
+std::vector<T> AVLTree<T, Allocator>::getElements(Node* node) const {
   std::vector<T> elements;
   if (node != nullptr) {
     std::vector<T> left_elements = getElements(node->left);
@@ -234,42 +285,65 @@ std::vector<T> AVLTree<T>::getElements(Node* node) const {
   return elements;
 }
 
-template <typename T>
-bool AVLTree<T>::isBalanced() const {
+template <typename T, typename Allocator>
+bool AVLTree<T, Allocator>::isBalanced() const {
   if(this->root == nullptr) {
     return true;
   }
   return (std::abs(this->root->getBalance()) < 2);
 }
 
-template <typename T>
-AVLTree<T>::AVLTree() {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::AVLTree() {
   this->root = nullptr;
 }
 
-template <typename T>
-AVLTree<T>::AVLTree(const AVLTree<T>& other) : root(copy(other.root)) {}
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::AVLTree(const Allocator& allocator)
+    : nodeAllocator(allocator) {}
+
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::AVLTree(const AVLTree<T, Allocator>& other)
+    : nodeAllocator(NodeTraits::select_on_container_copy_construction(
+          other.nodeAllocator)),
+      root(copy(other.root)) {}
 
-template <typename T>
-AVLTree<T>& AVLTree<T>::operator=(const AVLTree<T>& other) {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>& AVLTree<T, Allocator>::operator=(
+    const AVLTree<T, Allocator>& other) {
   if (this != &other) {
     free();
+    if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+      this->nodeAllocator = other.nodeAllocator;
+    }
     this->root = copy(other.root);
   }
   return *this;
 }
 
-template <typename T>
-AVLTree<T>::AVLTree(AVLTree<T>&& other) noexcept {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::AVLTree(AVLTree<T, Allocator>&& other) noexcept
+    : nodeAllocator(std::move(other.nodeAllocator)) {
   this->root = other.root;
 
   other.root = nullptr;
 }
 
-template <typename T>
-AVLTree<T>& AVLTree<T>::operator=(AVLTree<T>&& other) noexcept {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>& AVLTree<T, Allocator>::operator=(
+    AVLTree<T, Allocator>&& other)
+    noexcept(PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value) {
   if (this != &other) {
     free();
+    if constexpr (PROPAGATE_ON_MOVE) {
+      this->nodeAllocator = std::move(other.nodeAllocator);
+    } else if (this->nodeAllocator != other.nodeAllocator) {
+      // nodes cannot change resource, build new ones from the moved values
+      this->root = moveValues(other.root);
+      other.free();
+      other.root = nullptr;
+      return *this;
+    }
     this->root = other.root;
 
     other.root = nullptr;
@@ -277,29 +351,35 @@ AVLTree<T>& AVLTree<T>::operator=(AVLTree<T>&& other) noexcept {
   return *this;
 }
 
-template <typename T>
-AVLTree<T>::~AVLTree() {
+template <typename T, typename Allocator>
+AVLTree<T, Allocator>::~AVLTree() {
   free();
 }
 
-template <typename T>
-void AVLTree<T>::insert(const T& element) {
+template <typename T, typename Allocator>
+Allocator AVLTree<T, Allocator>::getAllocator() const {
+  return Allocator(this->nodeAllocator);
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::insert(const T& element) {
   this->root = insert(this->root, element);
 }
 
-template <typename T>
-void AVLTree<T>::remove(const T& element) {
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::remove(const T& element) {
   this->root = remove(this->root, element);
 }
 
-template <typename S>
-std::ostream& operator<<(std::ostream& outputStream, const AVLTree<S>& tree) {
+template <typename S, typename A>
+std::ostream& operator<<(
+    std::ostream& outputStream, const AVLTree<S, A>& tree) {
   outputStream << tree.print(tree.root, 0);
   return outputStream;
 }
 
-template <typename T>
-std::vector<T> AVLTree<T>::getElements() const {
+template <typename T, typename Allocator>
+std::vector<T> AVLTree<T, Allocator>::getElements() const {
   return getElements(this->root);
 }
 
@@ -2,10 +2,12 @@
 #define BINARY_TREE
 
 #include <cstddef>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class BinaryTree {
  public:
   struct Node {
@@ -13,14 +15,26 @@ class BinaryTree {
     Node* left;
     Node* right;
 
-    Node(const T& value, Node* left, Node* right)
-        : value(value), left(left), right(right) {}
+    template <typename V>
+    Node(V&& value, Node* left, Node* right)
+        : value(std::forward<V>(value)), left(left), right(right) {}
   };
 
  private:
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  static constexpr bool PROPAGATE_ON_MOVE =
+      NodeTraits::propagate_on_container_move_assignment::value;
+
+  [[no_unique_address]] NodeAllocator nodeAllocator;
   Node* root = nullptr;
   size_t size = 0;
+  template <typename V>
+  Node* createNode(V&& value, Node* left, Node* right);
+  void destroyNode(Node* node);
   Node* copy(Node* other);
+  Node* moveValues(Node* other);
   void freeNode(Node* node);
   void free();
   Node* insert(Node* parent, const T& value);
@@ -31,51 +45,86 @@ class BinaryTree {
 
  public:
   BinaryTree();
-  BinaryTree(const BinaryTree<T>& other);
-  BinaryTree& operator=(const BinaryTree<T>& other);
-  BinaryTree(BinaryTree<T>&& other) noexcept;
-  BinaryTree& operator=(BinaryTree<T>&& other) noexcept;
+  explicit BinaryTree(const Allocator& allocator);
+  BinaryTree(const BinaryTree<T, Allocator>& other);
+  BinaryTree& operator=(const BinaryTree<T, Allocator>& other);
+  BinaryTree(BinaryTree<T, Allocator>&& other) noexcept;
+  BinaryTree& operator=(BinaryTree<T, Allocator>&& other) noexcept(
+      PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value);
   ~BinaryTree();
+  [[nodiscard]] Allocator getAllocator() const;
   void insert(const T& element);
   void remove(const T& element);
   std::vector<T> getElements() const;
 
-  template <typename S>
+  template <typename S, typename A>
   friend std::ostream& operator<<(std::ostream& outputStream,
-                                  const BinaryTree<S>& tree);
+                                  const BinaryTree<S, A>& tree);
 };
 
-template <typename T>
-BinaryTree<T>::Node* BinaryTree<T>::copy(Node* other) {
+template <typename T, typename Allocator>
+template <typename V>
+BinaryTree<T, Allocator>::Node* BinaryTree<T, Allocator>::createNode(
+    V&& value, Node* left, Node* right) {
+  Node* node = NodeTraits::allocate(this->nodeAllocator, 1);
+  try {
+    NodeTraits::construct(this->nodeAllocator, node, std::forward<V>(value),
+                          left, right);
+  } catch (...) {
+    NodeTraits::deallocate(this->nodeAllocator, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::destroyNode(Node* node) {
+  NodeTraits::destroy(this->nodeAllocator, node);
+  NodeTraits::deallocate(this->nodeAllocator, node, 1);
+}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::Node* BinaryTree<T, Allocator>::copy(Node* other) {
   if (other == nullptr) {
     return nullptr;
   }
-  Node* root = new Node(other->value, nullptr, nullptr);
+  Node* root = createNode(other->value, nullptr, nullptr);
   root->left = copy(other->left);
   root->right = copy(other->right);
   return root;
 }
 
-template <typename T>
-void BinaryTree<T>::freeNode(Node* node) {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::Node* BinaryTree<T, Allocator>::moveValues(Node* other) {
+  if (other == nullptr) {
+    return nullptr;
+  }
+  Node* left = moveValues(other->left);
+  Node* right = moveValues(other->right);
+  return createNode(std::move(other->value), left, right);
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::freeNode(Node* node) {
   if (node == nullptr) {
     return;
   }
   freeNode(node->left);
   freeNode(node->right);
-  delete node;
+  destroyNode(node);
 }
 
-template <typename T>
-void BinaryTree<T>::free() {
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::free() {
   freeNode(this->root);
   this->size = 0;
 }
 
-template <typename T>
-BinaryTree<T>::Node* BinaryTree<T>::insert(Node* parent, const T& value) {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::Node* BinaryTree<T, Allocator>::insert(
+    Node* parent, const T& value) {
   if (parent == nullptr) {
-    return new Node(value, nullptr, nullptr);
+    return createNode(value, nullptr, nullptr);
     this->size++;
   }
   if (value < parent->value) {
@@ -86,8 +135,9 @@ BinaryTree<T>::Node* BinaryTree<T>::insert(Node* parent, const T& value) {
   return parent;
 }
 
-template <typename T>
-BinaryTree<T>::Node* BinaryTree<T>::remove(Node* parent, const T& value) {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::Node* BinaryTree<T, Allocator>::remove(
+    Node* parent, const T& value) {
   if (parent == nullptr) {
     return nullptr;
   }
@@ -95,12 +145,12 @@ BinaryTree<T>::Node* BinaryTree<T>::remove(Node* parent, const T& value) {
   if (value == parent->value) {
     if (parent->left == nullptr) {
       Node* temp = parent->right;
-      delete parent;
+      destroyNode(parent);
       return temp;
     }
     if (parent->right == nullptr) {
       Node* temp = parent->left;
-      delete parent;
+      destroyNode(parent);
       return temp;
     }
     Node* smallestInRightTree = smallestValueNode(parent->right);
@@ -116,8 +166,9 @@ BinaryTree<T>::Node* BinaryTree<T>::remove(Node* parent, const T& value) {
   return parent;
 }
 
-template <typename T>
-BinaryTree<T>::Node* BinaryTree<T>::smallestValueNode(Node* root) {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::Node* BinaryTree<T, Allocator>::smallestValueNode(
+    Node* root) {
   if (root == nullptr) {
     return root;
   }
@@ -128,8 +179,9 @@ BinaryTree<T>::Node* BinaryTree<T>::smallestValueNode(Node* root) {
   return smallestValueNode;
 }
 
-template <typename T>
-std::string BinaryTree<T>::print(Node* node, unsigned int level) const {
+template <typename T, typename Allocator>
+std::string BinaryTree<T, Allocator>::print(
+    Node* node, unsigned int level) const {
   std::string output;
   if (node != nullptr) {
     output = std::string("\t", level) + std::to_string(node->value);
@@ -143,8 +195,8 @@ std::string BinaryTree<T>::print(Node* node, unsigned int level) const {
   return output;
 }
 
-template <typename T>
-std::vector<T> BinaryTree<T>::getElements(Node* node) const {
+template <typename T, typename Allocator>
+std::vector<T> BinaryTree<T, Allocator>::getElements(Node* node) const {
   std::vector<T> elements;
   if (node != nullptr) {
     std::vector<T> left_elements = getElements(node->left);
@@ -157,28 +209,40 @@ std::vector<T> BinaryTree<T>::getElements(Node* node) const {
   return elements;
 }
 
-template <typename T>
-BinaryTree<T>::BinaryTree() {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::BinaryTree() {
   this->root = nullptr;
   this->size = 0;
 }
 
-template <typename T>
-BinaryTree<T>::BinaryTree(const BinaryTree<T>& other)
-    : size(other.size), root(copy(other.root)) {}
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::BinaryTree(const Allocator& allocator)
+    : nodeAllocator(allocator) {}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::BinaryTree(const BinaryTree<T, Allocator>& other)
+    : nodeAllocator(NodeTraits::select_on_container_copy_construction(
+          other.nodeAllocator)),
+      size(other.size),
+      root(copy(other.root)) {}
 
-template <typename T>
-BinaryTree<T>& BinaryTree<T>::operator=(const BinaryTree<T>& other) {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>& BinaryTree<T, Allocator>::operator=(
+    const BinaryTree<T, Allocator>& other) {
   if (this != &other) {
     free();
+    if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+      this->nodeAllocator = other.nodeAllocator;
+    }
     this->size = other.size;
     this->root = copy(other.root);
   }
   return *this;
 }
 
-template <typename T>
-BinaryTree<T>::BinaryTree(BinaryTree<T>&& other) noexcept {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::BinaryTree(BinaryTree<T, Allocator>&& other) noexcept
+    : nodeAllocator(std::move(other.nodeAllocator)) {
   this->size = other.size;
   this->root = other.root;
 
@@ -186,10 +250,23 @@ BinaryTree<T>::BinaryTree(BinaryTree<T>&& other) noexcept {
   other.root = nullptr;
 }
 
-template <typename T>
-BinaryTree<T>& BinaryTree<T>::operator=(BinaryTree<T>&& other) noexcept {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>& BinaryTree<T, Allocator>::operator=(
+    BinaryTree<T, Allocator>&& other)
+    noexcept(PROPAGATE_ON_MOVE || NodeTraits::is_always_equal::value) {
   if (this != &other) {
     free();
+    if constexpr (PROPAGATE_ON_MOVE) {
+      this->nodeAllocator = std::move(other.nodeAllocator);
+    } else if (this->nodeAllocator != other.nodeAllocator) {
+      // the nodes stay with the allocator that made them, rebuild the
+      // shape here around the moved values
+      this->size = other.size;
+      this->root = moveValues(other.root);
+      other.free();
+      other.root = nullptr;
+      return *this;
+    }
     this->size = other.size;
     this->root = other.root;
 
@@ -199,30 +276,35 @@ BinaryTree<T>& BinaryTree<T>::operator=(BinaryTree<T>&& other) noexcept {
   return *this;
 }
 
-template <typename T>
-BinaryTree<T>::~BinaryTree() {
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::~BinaryTree() {
   free();
 }
 
-template <typename T>
-void BinaryTree<T>::insert(const T& element) {
+template <typename T, typename Allocator>
+Allocator BinaryTree<T, Allocator>::getAllocator() const {
+  return Allocator(this->nodeAllocator);
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::insert(const T& element) {
   this->root = insert(this->root, element);
 }
 
-template <typename T>
-void BinaryTree<T>::remove(const T& element) {
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::remove(const T& element) {
   this->root = remove(this->root, element);
 }
 
-template <typename S>
+template <typename S, typename A>
 std::ostream& operator<<(std::ostream& outputStream,
-                         const BinaryTree<S>& tree) {
+                         const BinaryTree<S, A>& tree) {
   outputStream << tree.print(tree.root, 0);
   return outputStream;
 }
 
-template <typename T>
-std::vector<T> BinaryTree<T>::getElements() const {
+template <typename T, typename Allocator>
+std::vector<T> BinaryTree<T, Allocator>::getElements() const {
   return getElements(this->root);
 }
 
@@ -0,0 +1,70 @@
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+// Layout of a serialized Vector: this header followed by count raw elements in
+// native byte order. The header is 24 bytes, so the payload of a buffer that
+// is 8-aligned can be used in place.
+struct BinaryHeader {
+  static constexpr char MAGIC[4] = {'D', 'S', 'A', 'V'};
+  static constexpr uint32_t VERSION = 1;
+
+  char magic[4];
+  uint32_t version;
+  uint32_t elementSize;
+  uint32_t flags;
+  uint64_t count;
+
+  static BinaryHeader describe(size_t elementSize, size_t count) {
+    BinaryHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.elementSize = static_cast<uint32_t>(elementSize);
+    header.count = count;
+    return header;
+  }
+
+  void validate(size_t expectedElementSize) const {
+    if (std::memcmp(this->magic, MAGIC, sizeof(MAGIC)) != 0) {
+      throw std::runtime_error("Not a serialized Vector");
+    }
+    if (this->version != VERSION) {
+      throw std::runtime_error("Unsupported serialized Vector version");
+    }
+    if (this->elementSize != expectedElementSize) {
+      throw std::runtime_error("Serialized element size does not match");
+    }
+  }
+};
+static_assert(sizeof(BinaryHeader) == 24, "BinaryHeader must stay packed");
+
+// Zero-copy load: validates the header and returns the elements in place, so
+// the buffer (e.g. a mapped file) must outlive the returned span
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+std::span<const T> viewBinary(const void *buffer, size_t length) {
+  BinaryHeader header;
+  if (length < sizeof(header)) {
+    throw std::runtime_error("Serialized Vector is truncated");
+  }
+  std::memcpy(&header, buffer, sizeof(header));
+  header.validate(sizeof(T));
+  const std::byte *payload =
+      static_cast<const std::byte *>(buffer) + sizeof(header);
+  if (header.count > (length - sizeof(header)) / sizeof(T)) {
+    throw std::runtime_error("Serialized Vector is truncated");
+  }
+  if (reinterpret_cast<uintptr_t>(payload) % alignof(T) != 0) {
+    throw std::invalid_argument("Serialized payload is misaligned for T");
+  }
+  return {reinterpret_cast<const T *>(payload),
+          static_cast<size_t>(header.count)};
+}
+
+#endif  // !BINARY_FORMAT_H
@@ -0,0 +1,35 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <algorithm>
+#include <cstddef>
+
+// Growth policies pick the next capacity of a full Vector
+struct DoublingGrowth {
+  static size_t grow(size_t capacity, size_t /*elementSize*/) {
+    return capacity == 0 ? 1 : 2 * capacity;
+  }
+};
+
+struct OneAndHalfGrowth {
+  static size_t grow(size_t capacity, size_t /*elementSize*/) {
+    return capacity < 2 ? capacity + 1 : capacity + capacity / 2;
+  }
+};
+
+// Doubles small buffers; past one page grows by half and rounds up to whole
+// pages, so realloc-capable allocators can remap instead of copying
+struct PageAlignedGrowth {
+  static constexpr size_t PAGE_SIZE = 4096;
+
+  static size_t grow(size_t capacity, size_t elementSize) {
+    size_t bytes = capacity * elementSize;
+    if (bytes < PAGE_SIZE) {
+      return DoublingGrowth::grow(capacity, elementSize);
+    }
+    size_t pages = (bytes + bytes / 2 + PAGE_SIZE - 1) / PAGE_SIZE;
+    return std::max(pages * PAGE_SIZE / elementSize, capacity + 1);
+  }
+};
+
+#endif  // !GROWTH_POLICY_H
@@ -0,0 +1,41 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Owns a file descriptor and a mapping of the whole file. A read-only file
+// is mapped shared without write access, a read-write one shared, and a
+// copy-on-write one private, so writes stay in memory. Errors from the
+// system calls are thrown as std::system_error.
+class MappedFile {
+ public:
+  enum class Mode { READ_ONLY, READ_WRITE, COPY_ON_WRITE };
+
+ private:
+  int descriptor = -1;
+  std::byte *mapping = nullptr;
+  size_t length = 0;
+  Mode mode = Mode::READ_ONLY;
+
+  void map(size_t newLength);
+  void unmap();
+  void close();
+
+ public:
+  MappedFile(const std::string &path, Mode mode);
+  MappedFile(const MappedFile &other) = delete;
+  MappedFile &operator=(const MappedFile &other) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  ~MappedFile();
+  // Sets the file length and remaps it; previous pointers become invalid
+  void resize(size_t newLength);
+  // Flushes the first byteCount bytes of the mapping to the file
+  void sync(size_t byteCount) const;
+  [[nodiscard]] std::byte *data() const;
+  [[nodiscard]] size_t getLength() const;
+  [[nodiscard]] Mode getMode() const;
+};
+
+#endif  // !MAPPED_FILE_H
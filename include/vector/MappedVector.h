@@ -0,0 +1,227 @@
+#ifndef MAPPED_VECTOR_H
+#define MAPPED_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "GrowthPolicy.h"
+#include "MappedFile.h"
+
+// Vector whose elements live in a memory-mapped file, so datasets larger than
+// RAM are paged in on demand instead of being read up front. The file holds
+// the raw elements and nothing else. While open for writing the file may be
+// longer than the elements it holds; it is cut back to size on destruction.
+// The mode is part of the type: a read-only vector only hands out const
+// pointers, so searching it works and writing to it does not compile. A
+// copy-on-write vector cannot grow either, but its elements can be changed in
+// memory, say by an in-place sort; every page written takes memory and
+// nothing reaches the file.
+template <typename T, MappedFile::Mode MODE = MappedFile::Mode::READ_ONLY>
+class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedVector stores raw bytes, T must be trivially copyable");
+
+ public:
+  using Mode = MappedFile::Mode;
+
+ private:
+  static constexpr bool WRITABLE = MODE != Mode::READ_ONLY;
+  static constexpr bool GROWABLE = MODE == Mode::READ_WRITE;
+
+  MappedFile file;
+  size_t size;
+
+  T *array() const;
+  void trim() noexcept;
+
+ public:
+  explicit MappedVector(const std::string &path);
+  MappedVector(MappedVector &&other) noexcept;
+  MappedVector &operator=(MappedVector &&other) noexcept;
+  ~MappedVector();
+  size_t pushBack(const T &value)
+    requires GROWABLE;
+  void reserve(size_t newCapacity)
+    requires GROWABLE;
+  void sync() const;
+  [[nodiscard]] size_t getSize() const;
+  [[nodiscard]] size_t getCapacity() const;
+  [[nodiscard]] static constexpr bool isReadOnly();
+  T operator[](size_t index) const;
+  T &operator[](size_t index)
+    requires WRITABLE;
+  T *data()
+    requires WRITABLE;
+  const T *data() const;
+  T *begin()
+    requires WRITABLE;
+  T *end()
+    requires WRITABLE;
+  const T *begin() const;
+  const T *end() const;
+  template <typename S, MappedFile::Mode M>
+  friend std::ostream &operator<<(std::ostream &outputStream,
+                                  const MappedVector<S, M> &vector);
+};
+
+template <typename T, MappedFile::Mode MODE>
+T *MappedVector<T, MODE>::array() const {
+  return reinterpret_cast<T *>(this->file.data());
+}
+
+template <typename T, MappedFile::Mode MODE>
+MappedVector<T, MODE>::MappedVector(const std::string &path)
+    : file(path, MODE) {
+  if (this->file.getLength() % sizeof(T) != 0) {
+    throw std::runtime_error("File size is not a multiple of the element size");
+  }
+  this->size = this->file.getLength() / sizeof(T);
+}
+
+template <typename T, MappedFile::Mode MODE>
+MappedVector<T, MODE>::MappedVector(MappedVector &&other) noexcept
+    : file(std::move(other.file)), size(std::exchange(other.size, 0)) {}
+
+template <typename T, MappedFile::Mode MODE>
+MappedVector<T, MODE> &MappedVector<T, MODE>::operator=(
+    MappedVector &&other) noexcept {
+  if (this != &other) {
+    trim();
+    this->file = std::move(other.file);
+    this->size = std::exchange(other.size, 0);
+  }
+  return *this;
+}
+
+template <typename T, MappedFile::Mode MODE>
+MappedVector<T, MODE>::~MappedVector() {
+  trim();
+}
+
+template <typename T, MappedFile::Mode MODE>
+void MappedVector<T, MODE>::trim() noexcept {
+  if (GROWABLE && getCapacity() > this->size) {
+    try {
+      this->file.resize(this->size * sizeof(T));
+    } catch (...) {
+      // the spare capacity stays in the file, the elements are intact
+    }
+  }
+}
+
+template <typename T, MappedFile::Mode MODE>
+size_t MappedVector<T, MODE>::pushBack(const T &value)
+  requires GROWABLE
+{
+  if (this->size == getCapacity()) {
+    // value may point into the mapping that is about to move
+    T copy = value;
+    reserve(PageAlignedGrowth::grow(getCapacity(), sizeof(T)));
+    std::memcpy(array() + this->size, &copy, sizeof(T));
+  } else {
+    std::memcpy(array() + this->size, &value, sizeof(T));
+  }
+  return this->size++;
+}
+
+template <typename T, MappedFile::Mode MODE>
+void MappedVector<T, MODE>::reserve(size_t newCapacity)
+  requires GROWABLE
+{
+  if (newCapacity > getCapacity()) {
+    this->file.resize(newCapacity * sizeof(T));
+  }
+}
+
+template <typename T, MappedFile::Mode MODE>
+void MappedVector<T, MODE>::sync() const {
+  this->file.sync(this->size * sizeof(T));
+}
+
+template <typename T, MappedFile::Mode MODE>
+size_t MappedVector<T, MODE>::getSize() const {
+  return this->size;
+}
+
+template <typename T, MappedFile::Mode MODE>
+size_t MappedVector<T, MODE>::getCapacity() const {
+  return this->file.getLength() / sizeof(T);
+}
+
+template <typename T, MappedFile::Mode MODE>
+constexpr bool MappedVector<T, MODE>::isReadOnly() {
+  return !WRITABLE;
+}
+
+template <typename T, MappedFile::Mode MODE>
+T MappedVector<T, MODE>::operator[](size_t index) const {
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return array()[index];
+}
+
+template <typename T, MappedFile::Mode MODE>
+T &MappedVector<T, MODE>::operator[](size_t index)
+  requires WRITABLE
+{
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return array()[index];
+}
+
+template <typename T, MappedFile::Mode MODE>
+T *MappedVector<T, MODE>::data()
+  requires WRITABLE
+{
+  return array();
+}
+
+template <typename T, MappedFile::Mode MODE>
+const T *MappedVector<T, MODE>::data() const {
+  return array();
+}
+
+template <typename T, MappedFile::Mode MODE>
+T *MappedVector<T, MODE>::begin()
+  requires WRITABLE
+{
+  return array();
+}
+
+template <typename T, MappedFile::Mode MODE>
+T *MappedVector<T, MODE>::end()
+  requires WRITABLE
+{
+  return array() + this->size;
+}
+
+template <typename T, MappedFile::Mode MODE>
+const T *MappedVector<T, MODE>::begin() const {
+  return array();
+}
+
+template <typename T, MappedFile::Mode MODE>
+const T *MappedVector<T, MODE>::end() const {
+  return array() + this->size;
+}
+
+template <typename S, MappedFile::Mode M>
+std::ostream &operator<<(std::ostream &outputStream,
+                         const MappedVector<S, M> &vector) {
+  for (size_t i = 0; i < vector.size; i++) {
+    if (i > 0) {
+      outputStream << " ";
+    }
+    outputStream << vector.array()[i];
+  }
+  return outputStream;
+}
+
+#endif  // !MAPPED_VECTOR_H
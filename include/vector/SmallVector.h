@@ -0,0 +1,378 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Vector that keeps up to N elements inline and spills to the heap past N
+template <typename T, size_t N>
+class SmallVector {
+  static_assert(N > 0, "SmallVector needs room for at least one element");
+
+ private:
+  alignas(T) std::byte buffer[N * sizeof(T)];
+  T *array = inlineStorage();
+  size_t size = 0;
+  size_t capacity = N;
+
+  T *inlineStorage();
+  static T *allocate(size_t capacity);
+  static void deallocate(T *array, size_t capacity);
+  static void relocate(T *source, size_t count, T *destination);
+  void reallocate(size_t newCapacity);
+  void clear();
+  void releaseHeap();
+  void stealFrom(SmallVector &other);
+
+ public:
+  SmallVector() = default;
+  SmallVector(size_t size, const T &value);
+  SmallVector(const std::initializer_list<T> &initList);
+  SmallVector(const SmallVector &other);
+  SmallVector &operator=(const SmallVector &other);
+  SmallVector(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  SmallVector &operator=(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  ~SmallVector();
+  size_t pushBack(const T &value);
+  size_t pushBack(T &&value);
+  template <typename... Args>
+  T &emplaceBack(Args &&...args);
+  T erase(size_t index);
+  bool resize(size_t newSize);
+  void reserve(size_t newCapacity);
+  [[nodiscard]] size_t getSize() const;
+  [[nodiscard]] size_t getCapacity() const;
+  [[nodiscard]] bool isInline() const;
+  T operator[](size_t index) const;
+  T &operator[](size_t index);
+  T *begin();
+  T *end();
+  const T *begin() const;
+  const T *end() const;
+  template <typename S, size_t M>
+  friend std::ostream &operator<<(std::ostream &outputStream,
+                                  const SmallVector<S, M> &vector);
+};
+
+template <typename T, size_t N>
+T *SmallVector<T, N>::inlineStorage() {
+  return reinterpret_cast<T *>(this->buffer);
+}
+
+template <typename T, size_t N>
+T *SmallVector<T, N>::allocate(size_t capacity) {
+  return static_cast<T *>(::operator new(capacity * sizeof(T),
+                                         std::align_val_t{alignof(T)}));
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::deallocate(T *array, size_t capacity) {
+  ::operator delete(array, capacity * sizeof(T), std::align_val_t{alignof(T)});
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::relocate(T *source, size_t count, T *destination) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (count > 0) {
+      std::memcpy(static_cast<void *>(destination), source, count * sizeof(T));
+    }
+  } else {
+    // like Vector, the source goes only once every element arrived
+    size_t built = 0;
+    try {
+      for (; built < count; built++) {
+        ::new (static_cast<void *>(destination + built))
+            T(std::move_if_noexcept(source[built]));
+      }
+    } catch (...) {
+      std::destroy(destination, destination + built);
+      throw;
+    }
+    std::destroy(source, source + count);
+  }
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::reallocate(size_t newCapacity) {
+  T *newArray = allocate(newCapacity);
+  try {
+    relocate(this->array, this->size, newArray);
+  } catch (...) {
+    deallocate(newArray, newCapacity);
+    throw;
+  }
+  if (!isInline()) {
+    deallocate(this->array, this->capacity);
+  }
+  this->array = newArray;
+  this->capacity = newCapacity;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::clear() {
+  std::destroy(this->begin(), this->end());
+  if (!isInline()) {
+    deallocate(this->array, this->capacity);
+  }
+  this->array = inlineStorage();
+  this->size = 0;
+  this->capacity = N;
+}
+
+// Frees a heap buffer whose elements are already destroyed, for
+// constructors that fail part way
+template <typename T, size_t N>
+void SmallVector<T, N>::releaseHeap() {
+  if (!isInline()) {
+    deallocate(this->array, this->capacity);
+  }
+  this->array = inlineStorage();
+  this->capacity = N;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::stealFrom(SmallVector &other) {
+  if (other.isInline()) {
+    // inline elements cannot change owner, move them one by one
+    relocate(other.array, other.size, this->array);
+  } else {
+    this->array = other.array;
+    this->capacity = other.capacity;
+  }
+  this->size = other.size;
+  other.array = other.inlineStorage();
+  other.size = 0;
+  other.capacity = N;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(size_t size, const T &value) {
+  reserve(size);
+  try {
+    std::uninitialized_fill_n(this->array, size, value);
+  } catch (...) {
+    releaseHeap();
+    throw;
+  }
+  this->size = size;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const std::initializer_list<T> &initList) {
+  reserve(initList.size());
+  try {
+    std::uninitialized_copy(initList.begin(), initList.end(), this->array);
+  } catch (...) {
+    releaseHeap();
+    throw;
+  }
+  this->size = initList.size();
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector &other) {
+  reserve(other.size);
+  try {
+    std::uninitialized_copy(other.begin(), other.end(), this->array);
+  } catch (...) {
+    releaseHeap();
+    throw;
+  }
+  this->size = other.size;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N> &SmallVector<T, N>::operator=(const SmallVector &other) {
+  if (this != &other) {
+    clear();
+    reserve(other.size);
+    std::uninitialized_copy(other.begin(), other.end(), this->array);
+    this->size = other.size;
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+  stealFrom(other);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N> &SmallVector<T, N>::operator=(SmallVector &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+  if (this != &other) {
+    clear();
+    stealFrom(other);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::~SmallVector() {
+  clear();
+}
+
+template <typename T, size_t N>
+size_t SmallVector<T, N>::pushBack(const T &value) {
+  emplaceBack(value);
+  return this->size - 1;
+}
+
+template <typename T, size_t N>
+size_t SmallVector<T, N>::pushBack(T &&value) {
+  emplaceBack(std::move(value));
+  return this->size - 1;
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T &SmallVector<T, N>::emplaceBack(Args &&...args) {
+  if (this->size == this->capacity) {
+    // construct the new element before relocating, args may live in array
+    size_t newCapacity = 2 * this->capacity;
+    T *newArray = allocate(newCapacity);
+    try {
+      ::new (static_cast<void *>(newArray + this->size))
+          T(std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+    try {
+      relocate(this->array, this->size, newArray);
+    } catch (...) {
+      std::destroy_at(newArray + this->size);
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+    if (!isInline()) {
+      deallocate(this->array, this->capacity);
+    }
+    this->array = newArray;
+    this->capacity = newCapacity;
+  } else {
+    ::new (static_cast<void *>(this->array + this->size))
+        T(std::forward<Args>(args)...);
+  }
+  this->size++;
+  return this->array[this->size - 1];
+}
+
+template <typename T, size_t N>
+T SmallVector<T, N>::erase(size_t index) {
+  if (index >= this->size) {
+    throw std::out_of_range("Provided index is out of range");
+  }
+  T temp = std::move(this->array[index]);
+  std::move(this->array + index + 1, this->array + this->size,
+            this->array + index);
+  this->size--;
+  std::destroy_at(this->array + this->size);
+  return temp;
+}
+
+// Sets the capacity like Vector::resize, dropping the elements past
+// newSize; a capacity of N or less moves the elements back inline
+template <typename T, size_t N>
+bool SmallVector<T, N>::resize(size_t newSize) {
+  if (newSize < this->size) {
+    std::destroy(this->array + newSize, this->array + this->size);
+    this->size = newSize;
+  }
+  if (newSize <= N) {
+    if (!isInline()) {
+      T *heapArray = this->array;
+      size_t heapCapacity = this->capacity;
+      relocate(heapArray, this->size, inlineStorage());
+      deallocate(heapArray, heapCapacity);
+      this->array = inlineStorage();
+      this->capacity = N;
+    }
+  } else if (newSize != this->capacity) {
+    reallocate(newSize);
+  }
+  return true;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::reserve(size_t newCapacity) {
+  if (newCapacity > this->capacity) {
+    reallocate(newCapacity);
+  }
+}
+
+template <typename T, size_t N>
+size_t SmallVector<T, N>::getSize() const {
+  return this->size;
+}
+
+template <typename T, size_t N>
+size_t SmallVector<T, N>::getCapacity() const {
+  return this->capacity;
+}
+
+template <typename T, size_t N>
+bool SmallVector<T, N>::isInline() const {
+  return this->array == reinterpret_cast<const T *>(this->buffer);
+}
+
+template <typename T, size_t N>
+T SmallVector<T, N>::operator[](size_t index) const {
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return this->array[index];
+}
+
+template <typename T, size_t N>
+T &SmallVector<T, N>::operator[](size_t index) {
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return this->array[index];
+}
+
+template <typename T, size_t N>
+T *SmallVector<T, N>::begin() {
+  return this->array;
+}
+
+template <typename T, size_t N>
+T *SmallVector<T, N>::end() {
+  return this->array + this->size;
+}
+
+template <typename T, size_t N>
+const T *SmallVector<T, N>::begin() const {
+  return this->array;
+}
+
+template <typename T, size_t N>
+const T *SmallVector<T, N>::end() const {
+  return this->array + this->size;
+}
+
+template <typename S, size_t M>
+std::ostream &operator<<(std::ostream &outputStream,
+                         const SmallVector<S, M> &vector) {
+  for (size_t i = 0; i < vector.size; i++) {
+    if (i > 0) {
+      outputStream << " ";
+    }
+    outputStream << vector.array[i];
+  }
+  return outputStream;
+}
+
+#endif  // !SMALL_VECTOR_H
@@ -0,0 +1,277 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "Sorting.h"
+#include "Vector.h"
+
+// Structure of arrays: every field lives in its own contiguous Vector, so a
+// pass over one field only touches that field's cache lines. Rows are exposed
+// as tuples of references, which keeps structured bindings and row loops
+// working as they would over a Vector of records.
+template <typename... Fields>
+class SoAVector {
+  static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+ public:
+  template <size_t I>
+  using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+  using Row = std::tuple<Fields &...>;
+  using ConstRow = std::tuple<const Fields &...>;
+
+  template <bool IS_CONST>
+  class RowIterator {
+   private:
+    using Owner = std::conditional_t<IS_CONST, const SoAVector, SoAVector>;
+    Owner *owner;
+    size_t index;
+
+   public:
+    RowIterator(Owner *owner, size_t index) : owner(owner), index(index) {}
+
+    RowIterator &operator++() {
+      this->index++;
+      return *this;
+    }
+
+    bool operator==(const RowIterator &other) const {
+      return this->index == other.index;
+    }
+
+    bool operator!=(const RowIterator &other) const {
+      return this->index != other.index;
+    }
+
+    auto operator*() const {
+      return this->owner->rowAt(this->index,
+                                std::index_sequence_for<Fields...>());
+    }
+  };
+  using Iterator = RowIterator<false>;
+  using ConstIterator = RowIterator<true>;
+
+ private:
+  std::tuple<Vector<Fields>...> columns;
+  size_t size = 0;
+
+  template <size_t... I>
+  Row rowAt(size_t index, std::index_sequence<I...>);
+  template <size_t... I>
+  ConstRow rowAt(size_t index, std::index_sequence<I...>) const;
+  template <size_t... I>
+  void reserveColumns(size_t newCapacity, std::index_sequence<I...>);
+  template <size_t I>
+  void pushColumnsFrom(const ConstRow &row);
+  template <size_t... I>
+  std::tuple<Fields...> eraseColumns(size_t index, std::index_sequence<I...>);
+  template <size_t... I>
+  void permuteColumns(const Vector<size_t> &order, std::index_sequence<I...>);
+  template <size_t I>
+  void permuteColumn(const Vector<size_t> &order);
+
+ public:
+  SoAVector() = default;
+  SoAVector(const std::initializer_list<std::tuple<Fields...>> &initList);
+  size_t pushBack(const Fields &...values);
+  std::tuple<Fields...> erase(size_t index);
+  void reserve(size_t newCapacity);
+  [[nodiscard]] size_t getSize() const;
+  template <size_t I>
+  std::span<Field<I>> column();
+  template <size_t I>
+  std::span<const Field<I>> column() const;
+  // Reorders whole rows so that column I is sorted; ties keep their order
+  template <size_t I, typename Compare = std::less<>>
+  void sortBy(Compare compare = Compare());
+  Row operator[](size_t index);
+  ConstRow operator[](size_t index) const;
+  Iterator begin();
+  Iterator end();
+  ConstIterator begin() const;
+  ConstIterator end() const;
+};
+
+template <typename... Fields>
+template <size_t... I>
+typename SoAVector<Fields...>::Row SoAVector<Fields...>::rowAt(
+    size_t index, std::index_sequence<I...>) {
+  return Row(std::get<I>(this->columns).unchecked(index)...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+typename SoAVector<Fields...>::ConstRow SoAVector<Fields...>::rowAt(
+    size_t index, std::index_sequence<I...>) const {
+  return ConstRow(std::get<I>(this->columns).unchecked(index)...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::reserveColumns(size_t newCapacity,
+                                          std::index_sequence<I...>) {
+  (std::get<I>(this->columns).reserve(newCapacity), ...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+std::tuple<Fields...> SoAVector<Fields...>::eraseColumns(
+    size_t index, std::index_sequence<I...>) {
+  return std::tuple<Fields...>(std::get<I>(this->columns).erase(index)...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::permuteColumns(const Vector<size_t> &order,
+                                          std::index_sequence<I...>) {
+  (permuteColumn<I>(order), ...);
+}
+
+template <typename... Fields>
+template <size_t I>
+void SoAVector<Fields...>::permuteColumn(const Vector<size_t> &order) {
+  Vector<Field<I>> &column = std::get<I>(this->columns);
+  Vector<Field<I>> permuted(this->size);
+  for (size_t index : order) {
+    permuted.pushBack(std::move(column.unchecked(index)));
+  }
+  column = std::move(permuted);
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(
+    const std::initializer_list<std::tuple<Fields...>> &initList) {
+  reserve(initList.size());
+  for (const auto &row : initList) {
+    std::apply([this](const Fields &...values) { pushBack(values...); }, row);
+  }
+}
+
+template <typename... Fields>
+size_t SoAVector<Fields...>::pushBack(const Fields &...values) {
+  // reserve first, so a failed allocation cannot leave the columns uneven
+  if (this->size == std::get<0>(this->columns).getCapacity()) {
+    // values may live in the columns that reserve frees
+    std::tuple<Fields...> row(values...);
+    reserve(std::max<size_t>(2 * this->size, 1));
+    pushColumnsFrom<0>(ConstRow(row));
+  } else {
+    pushColumnsFrom<0>(ConstRow(values...));
+  }
+  return this->size++;
+}
+
+// Appends field I onwards. Every column has spare capacity, so a failing
+// copy leaves its own column alone, and the columns before it drop the
+// field they already took.
+template <typename... Fields>
+template <size_t I>
+void SoAVector<Fields...>::pushColumnsFrom(const ConstRow &row) {
+  if constexpr (I < sizeof...(Fields)) {
+    auto &column = std::get<I>(this->columns);
+    column.pushBack(std::get<I>(row));
+    try {
+      pushColumnsFrom<I + 1>(row);
+    } catch (...) {
+      column.eraseRange(this->size, this->size + 1);
+      throw;
+    }
+  }
+}
+
+template <typename... Fields>
+std::tuple<Fields...> SoAVector<Fields...>::erase(size_t index) {
+  if (index >= this->size) {
+    throw std::out_of_range("Provided index is out of range");
+  }
+  std::tuple<Fields...> row =
+      eraseColumns(index, std::index_sequence_for<Fields...>());
+  this->size--;
+  return row;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::reserve(size_t newCapacity) {
+  reserveColumns(newCapacity, std::index_sequence_for<Fields...>());
+}
+
+template <typename... Fields>
+size_t SoAVector<Fields...>::getSize() const {
+  return this->size;
+}
+
+template <typename... Fields>
+template <size_t I>
+std::span<typename SoAVector<Fields...>::template Field<I>>
+SoAVector<Fields...>::column() {
+  return {std::get<I>(this->columns).data(), this->size};
+}
+
+template <typename... Fields>
+template <size_t I>
+std::span<const typename SoAVector<Fields...>::template Field<I>>
+SoAVector<Fields...>::column() const {
+  return {std::get<I>(this->columns).data(), this->size};
+}
+
+template <typename... Fields>
+template <size_t I, typename Compare>
+void SoAVector<Fields...>::sortBy(Compare compare) {
+  Vector<size_t> order(this->size);
+  for (size_t i = 0; i < this->size; i++) {
+    order.pushBack(i);
+  }
+  std::span<const Field<I>> key = std::as_const(*this).template column<I>();
+  mergeSort(order.begin(), order.end(), std::move(compare),
+            [&key](size_t row) -> const Field<I> & { return key[row]; });
+  permuteColumns(order, std::index_sequence_for<Fields...>());
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Row SoAVector<Fields...>::operator[](
+    size_t index) {
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return rowAt(index, std::index_sequence_for<Fields...>());
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstRow SoAVector<Fields...>::operator[](
+    size_t index) const {
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return rowAt(index, std::index_sequence_for<Fields...>());
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Iterator SoAVector<Fields...>::begin() {
+  return Iterator(this, 0);
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Iterator SoAVector<Fields...>::end() {
+  return Iterator(this, this->size);
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstIterator SoAVector<Fields...>::begin()
+    const {
+  return ConstIterator(this, 0);
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstIterator SoAVector<Fields...>::end()
+    const {
+  return ConstIterator(this, this->size);
+}
+
+#endif  // !SOA_VECTOR_H
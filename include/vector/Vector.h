@@ -1,106 +1,218 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
 #include <ostream>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "BinaryFormat.h"
+#include "GrowthPolicy.h"
 
 #define DEFAULT_CAPACITY 16
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = DoublingGrowth>
 class Vector {
  private:
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+  static constexpr bool PROPAGATE_ON_MOVE =
+      AllocatorTraits::propagate_on_container_move_assignment::value;
+  static constexpr bool PROPAGATE_ON_COPY =
+      AllocatorTraits::propagate_on_container_copy_assignment::value;
+  // allocators with reallocate() (e.g. realloc) may resize without relocating
+  static constexpr bool REALLOCATES_IN_PLACE =
+      std::is_trivially_copyable_v<T> &&
+      requires(Allocator &allocator, T *array, size_t count) {
+        allocator.reallocate(array, count, count);
+      };
+
+  [[no_unique_address]] Allocator allocator;
   T *array = nullptr;
   size_t size = 0;
   size_t capacity = DEFAULT_CAPACITY;
 
+  // storage is raw memory; only the first size slots hold constructed objects
+  T *allocate(size_t capacity);
+  void deallocate(T *array, size_t capacity);
+  template <typename... Args>
+  void construct(T *slot, Args &&...args);
+  void destroy(T *first, T *last);
+  template <typename InputIt>
+  void constructRange(InputIt first, InputIt last, T *destination);
+  void relocate(T *source, size_t count, T *destination);
+  void reallocate(size_t newCapacity);
+  [[nodiscard]] size_t grownCapacity() const;
+  void release();
+  void steal(Vector &other);
+
  public:
   Vector();
-  Vector(size_t capacity);
-  Vector(size_t size, const T &value);
-  Vector(const std::initializer_list<T> &initList);
-  Vector(const Vector<T> &other);
-  Vector &operator=(const Vector<T> &other);
-  Vector(Vector<T> &&other) noexcept;
-  Vector &operator=(Vector<T> &&other) noexcept;
+  explicit Vector(const Allocator &allocator);
+  Vector(size_t capacity, const Allocator &allocator = Allocator());
+  Vector(size_t size, const T &value, const Allocator &allocator = Allocator());
+  Vector(const std::initializer_list<T> &initList,
+         const Allocator &allocator = Allocator());
+  Vector(const Vector<T, Allocator, GrowthPolicy> &other);
+  Vector &operator=(const Vector<T, Allocator, GrowthPolicy> &other);
+  Vector(Vector<T, Allocator, GrowthPolicy> &&other) noexcept;
+  Vector &operator=(Vector<T, Allocator, GrowthPolicy> &&other) noexcept(
+      PROPAGATE_ON_MOVE || AllocatorTraits::is_always_equal::value);
   ~Vector();
+  [[nodiscard]] Allocator getAllocator() const;
   size_t pushBack(const T &value);
+  size_t pushBack(T &&value);
+  template <typename... Args>
+  T &emplaceBack(Args &&...args);
+  template <typename InputIt>
+  void append(InputIt first, InputIt last);
   T erase(size_t index);
+  void eraseRange(size_t first, size_t last);
+  template <typename Predicate>
+  size_t eraseIf(Predicate predicate);
+  T swapErase(size_t index);
   bool resize(size_t newSize);
+  void reserve(size_t newCapacity);
+  void shrinkToFit();
   [[nodiscard]] size_t getSize() const;
   [[nodiscard]] size_t getCapacity() const;
   T operator[](size_t index) const;
   T &operator[](size_t index);
+  const T &at(size_t index) const;
+  T &at(size_t index);
+  const T &unchecked(size_t index) const;
+  T &unchecked(size_t index);
+  T *data();
+  const T *data() const;
   T *begin();
   T *end();
   const T *begin() const;
   const T *end() const;
-  template <typename S>
+  void writeBinary(std::ostream &outputStream) const
+    requires std::is_trivially_copyable_v<T>;
+  static Vector readBinary(std::istream &inputStream,
+                           const Allocator &allocator = Allocator())
+    requires std::is_trivially_copyable_v<T>;
+  template <typename S, typename A, typename G>
   friend std::ostream &operator<<(std::ostream &outputStream,
-                                  const Vector<S> &vector);
+                                  const Vector<S, A, G> &vector);
 };
 
-template <typename T>
-Vector<T>::Vector() {
-  this->size = 0;
-  this->capacity = DEFAULT_CAPACITY;
-  this->array = new T[this->capacity];
+template <typename T, typename Allocator, typename GrowthPolicy>
+T *Vector<T, Allocator, GrowthPolicy>::allocate(size_t capacity) {
+  if (capacity == 0) {
+    return nullptr;
+  }
+  return AllocatorTraits::allocate(this->allocator, capacity);
 }
 
-template <typename T>
-Vector<T>::Vector(size_t capacity) {
-  this->size = 0;
-  this->capacity = capacity;
-  this->array = new T[this->capacity];
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::deallocate(T *array, size_t capacity) {
+  if (array != nullptr) {
+    AllocatorTraits::deallocate(this->allocator, array, capacity);
+  }
 }
 
-template <typename T>
-Vector<T>::Vector(size_t size, const T &value) {
-  this->size = size;
-  this->capacity = 2 * size;
-  this->array = new T[this->capacity];
-  for (size_t i = 0; i < this->size; i++) {
-    this->array[i] = value;
-  }
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+void Vector<T, Allocator, GrowthPolicy>::construct(T *slot, Args &&...args) {
+  AllocatorTraits::construct(this->allocator, slot,
+                             std::forward<Args>(args)...);
 }
 
-template <typename T>
-Vector<T>::Vector(const std::initializer_list<T> &initList) {
-  this->resize(initList.size());
-  for (const T &value : initList) {
-    this->array[this->size++] = value;
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::destroy(T *first, T *last) {
+  for (; first != last; ++first) {
+    AllocatorTraits::destroy(this->allocator, first);
   }
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector &other) {
-  this->size = other.size;
-  this->capacity = other.capacity;
-  this->array = new T[this->capacity];
-  for (size_t i = 0; i < this->size; i++) {
-    this->array[i] = other.array[i];
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename InputIt>
+void Vector<T, Allocator, GrowthPolicy>::constructRange(InputIt first,
+                                                        InputIt last,
+                                                        T *destination) {
+  T *current = destination;
+  try {
+    for (; first != last; ++first, ++current) {
+      construct(current, *first);
+    }
+  } catch (...) {
+    destroy(destination, current);
+    throw;
   }
 }
 
-template <typename T>
-Vector<T> &Vector<T>::operator=(const Vector<T> &other) {
-  if (this != &other) {
-    if (this->array != nullptr) {
-      delete[] this->array;
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::relocate(
+    T *source, size_t count, T *destination) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (count > 0) {
+      std::memcpy(static_cast<void *>(destination), source, count * sizeof(T));
     }
+  } else {
+    // the source is destroyed only once every element arrived, so a
+    // throwing copy leaves it untouched
+    size_t built = 0;
+    try {
+      for (; built < count; built++) {
+        construct(destination + built, std::move_if_noexcept(source[built]));
+      }
+    } catch (...) {
+      destroy(destination, destination + built);
+      throw;
+    }
+    destroy(source, source + count);
+  }
+}
 
-    this->size = other.size;
-    this->capacity = other.capacity;
-
-    this->array = new T[this->capacity];
-    for (size_t i = 0; i < this->size; i++) {
-      this->array[i] = other.array[i];
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::reallocate(size_t newCapacity) {
+  if constexpr (REALLOCATES_IN_PLACE) {
+    if (this->array != nullptr && newCapacity > 0) {
+      this->array = this->allocator.reallocate(this->array, this->capacity,
+                                               newCapacity);
+      this->capacity = newCapacity;
+      return;
     }
   }
-  return *this;
+  T *newArray = allocate(newCapacity);
+  try {
+    relocate(this->array, this->size, newArray);
+  } catch (...) {
+    deallocate(newArray, newCapacity);
+    throw;
+  }
+  deallocate(this->array, this->capacity);
+  this->array = newArray;
+  this->capacity = newCapacity;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t Vector<T, Allocator, GrowthPolicy>::grownCapacity() const {
+  return std::max(GrowthPolicy::grow(this->capacity, sizeof(T)),
+                  this->capacity + 1);
 }
 
-template <typename T>
-Vector<T>::Vector(Vector<T> &&other) noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::release() {
+  destroy(this->begin(), this->end());
+  deallocate(this->array, this->capacity);
+  this->array = nullptr;
+  this->size = 0;
+  this->capacity = 0;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::steal(Vector &other) {
   this->size = other.size;
   this->capacity = other.capacity;
   this->array = other.array;
@@ -109,120 +221,437 @@ Vector<T>::Vector(Vector<T> &&other) noexcept {
   other.array = nullptr;
 }
 
-template <typename T>
-Vector<T> &Vector<T>::operator=(Vector<T> &&other) noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector() : Vector(DEFAULT_CAPACITY) {}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(const Allocator &allocator)
+    : Vector(DEFAULT_CAPACITY, allocator) {}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(size_t capacity,
+                                           const Allocator &allocator)
+    : allocator(allocator) {
+  this->size = 0;
+  this->capacity = capacity;
+  this->array = allocate(this->capacity);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(size_t size, const T &value,
+                                           const Allocator &allocator)
+    : Vector(2 * size, allocator) {
+  try {
+    for (; this->size < size; this->size++) {
+      construct(this->array + this->size, value);
+    }
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(
+    const std::initializer_list<T> &initList, const Allocator &allocator)
+    : Vector(initList.size(), allocator) {
+  try {
+    constructRange(initList.begin(), initList.end(), this->array);
+  } catch (...) {
+    release();
+    throw;
+  }
+  this->size = initList.size();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(const Vector &other)
+    : Vector(other.capacity,
+             AllocatorTraits::select_on_container_copy_construction(
+                 other.allocator)) {
+  try {
+    constructRange(other.begin(), other.end(), this->array);
+  } catch (...) {
+    release();
+    throw;
+  }
+  this->size = other.size;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy> &
+Vector<T, Allocator, GrowthPolicy>::operator=(const Vector &other) {
   if (this != &other) {
-    this->size = other.size;
-    this->capacity = other.capacity;
-    if (this->array != nullptr) {
-      delete[] this->array;
+    Vector copy(other.capacity,
+                PROPAGATE_ON_COPY ? other.allocator : this->allocator);
+    copy.append(other.begin(), other.end());
+    release();
+    if constexpr (PROPAGATE_ON_COPY) {
+      this->allocator = other.allocator;
     }
-    this->array = other.array;
-    other.size = 0;
-    other.capacity = 0;
-    other.array = nullptr;
+    steal(copy);
   }
   return *this;
 }
 
-template <typename T>
-Vector<T>::~Vector() {
-  if (this->array != nullptr) {
-    delete[] this->array;
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(Vector &&other) noexcept
+    : allocator(std::move(other.allocator)) {
+  steal(other);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy> &
+Vector<T, Allocator, GrowthPolicy>::operator=(Vector &&other) noexcept(
+    PROPAGATE_ON_MOVE || AllocatorTraits::is_always_equal::value) {
+  if (this == &other) {
+    return *this;
   }
+  if constexpr (PROPAGATE_ON_MOVE) {
+    release();
+    this->allocator = std::move(other.allocator);
+    steal(other);
+  } else {
+    if (this->allocator == other.allocator) {
+      release();
+      steal(other);
+    } else {
+      // memory from another resource cannot change owner, move elementwise
+      Vector moved(other.capacity, this->allocator);
+      for (T &element : other) {
+        moved.emplaceBack(std::move(element));
+      }
+      release();
+      steal(moved);
+    }
+  }
+  return *this;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::~Vector() {
+  release();
 }
 
-template <typename T>
-size_t Vector<T>::pushBack(const T &value) {
+template <typename T, typename Allocator, typename GrowthPolicy>
+Allocator Vector<T, Allocator, GrowthPolicy>::getAllocator() const {
+  return this->allocator;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t Vector<T, Allocator, GrowthPolicy>::pushBack(const T &value) {
+  emplaceBack(value);
+  return this->size - 1;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t Vector<T, Allocator, GrowthPolicy>::pushBack(T &&value) {
+  emplaceBack(std::move(value));
+  return this->size - 1;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+T &Vector<T, Allocator, GrowthPolicy>::emplaceBack(Args &&...args) {
+  if constexpr (REALLOCATES_IN_PLACE) {
+    if (this->size == this->capacity) {
+      // args may live in array, which reallocate can move
+      T value(std::forward<Args>(args)...);
+      reallocate(grownCapacity());
+      construct(this->array + this->size, std::move(value));
+      this->size++;
+      return this->array[this->size - 1];
+    }
+  }
   if (this->size == this->capacity) {
-    this->resize(2 * this->capacity);
+    // construct the new element before relocating, args may live in array
+    size_t newCapacity = grownCapacity();
+    T *newArray = allocate(newCapacity);
+    try {
+      construct(newArray + this->size, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+    try {
+      relocate(this->array, this->size, newArray);
+    } catch (...) {
+      destroy(newArray + this->size, newArray + this->size + 1);
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+    deallocate(this->array, this->capacity);
+    this->array = newArray;
+    this->capacity = newCapacity;
+  } else {
+    construct(this->array + this->size, std::forward<Args>(args)...);
   }
-  this->array[this->size] = value;
   this->size++;
-  return this->size - 1;
+  return this->array[this->size - 1];
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename InputIt>
+void Vector<T, Allocator, GrowthPolicy>::append(InputIt first, InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    size_t count = std::distance(first, last);
+    if (this->size + count <= this->capacity) {
+      constructRange(first, last, this->array + this->size);
+    } else {
+      // grow once; copy first, the range may point into array
+      size_t newCapacity = std::max(this->size + count, grownCapacity());
+      T *newArray = allocate(newCapacity);
+      try {
+        constructRange(first, last, newArray + this->size);
+      } catch (...) {
+        deallocate(newArray, newCapacity);
+        throw;
+      }
+      try {
+        relocate(this->array, this->size, newArray);
+      } catch (...) {
+        destroy(newArray + this->size, newArray + this->size + count);
+        deallocate(newArray, newCapacity);
+        throw;
+      }
+      deallocate(this->array, this->capacity);
+      this->array = newArray;
+      this->capacity = newCapacity;
+    }
+    this->size += count;
+  } else {
+    for (; first != last; ++first) {
+      emplaceBack(*first);
+    }
+  }
 }
 
-template <typename T>
-T Vector<T>::erase(size_t index) {
+template <typename T, typename Allocator, typename GrowthPolicy>
+T Vector<T, Allocator, GrowthPolicy>::erase(size_t index) {
   if (index < 0 || index >= this->size) {
     throw std::out_of_range("Provided index is out of range");
   }
-  T temp = this->array[index];
-  for (size_t i = index; i < this->size - 1; i++) {
-    this->array[i] = this->array[i + 1];
+  T temp = std::move(this->array[index]);
+  std::move(this->array + index + 1, this->array + this->size,
+            this->array + index);
+  this->size--;
+  AllocatorTraits::destroy(this->allocator, this->array + this->size);
+  return temp;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::eraseRange(size_t first, size_t last) {
+  if (first > last || last > this->size) {
+    throw std::out_of_range("Provided range is out of range");
+  }
+  std::move(this->array + last, this->array + this->size, this->array + first);
+  size_t newSize = this->size - (last - first);
+  destroy(this->array + newSize, this->array + this->size);
+  this->size = newSize;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename Predicate>
+size_t Vector<T, Allocator, GrowthPolicy>::eraseIf(Predicate predicate) {
+  // compact the kept elements to the front in one pass
+  size_t kept = 0;
+  for (size_t i = 0; i < this->size; i++) {
+    if (!predicate(this->array[i])) {
+      if (kept != i) {
+        this->array[kept] = std::move(this->array[i]);
+      }
+      kept++;
+    }
   }
+  size_t erased = this->size - kept;
+  destroy(this->array + kept, this->array + this->size);
+  this->size = kept;
+  return erased;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T Vector<T, Allocator, GrowthPolicy>::swapErase(size_t index) {
+  if (index >= this->size) {
+    throw std::out_of_range("Provided index is out of range");
+  }
+  T temp = std::move(this->array[index]);
   this->size--;
+  if (index != this->size) {
+    this->array[index] = std::move(this->array[this->size]);
+  }
+  AllocatorTraits::destroy(this->allocator, this->array + this->size);
   return temp;
 }
 
-template <typename T>
-bool Vector<T>::resize(size_t newSize) {
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool Vector<T, Allocator, GrowthPolicy>::resize(size_t newSize) {
   if (newSize < 0) {
     throw std::out_of_range("Invalid new size");
   }
-  this->capacity = newSize;
-  this->size = std::min(this->size, this->capacity);
-  T *newArray = new T[this->capacity];
-  for (size_t i = 0; i < this->size; i++) {
-    newArray[i] = this->array[i];
+  if (newSize < this->size) {
+    destroy(this->array + newSize, this->array + this->size);
+    this->size = newSize;
   }
-  delete[] this->array;
-  this->array = newArray;
+  reallocate(newSize);
   return true;
 }
 
-template <typename T>
-T Vector<T>::operator[](size_t index) const {
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::reserve(size_t newCapacity) {
+  if (newCapacity > this->capacity) {
+    reallocate(newCapacity);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::shrinkToFit() {
+  if (this->capacity > this->size) {
+    reallocate(this->size);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T Vector<T, Allocator, GrowthPolicy>::operator[](size_t index) const {
   if (index < 0 || index >= this->size) {
     throw std::out_of_range("Invalid range of element");
   }
   return this->array[index];
 }
 
-template <typename T>
-T &Vector<T>::operator[](size_t index) {
+template <typename T, typename Allocator, typename GrowthPolicy>
+T &Vector<T, Allocator, GrowthPolicy>::operator[](size_t index) {
   if (index < 0 || index >= this->size) {
     throw std::out_of_range("Invalid range of element");
   }
   return this->array[index];
 }
 
-template <typename T>
-size_t Vector<T>::getSize() const {
+template <typename T, typename Allocator, typename GrowthPolicy>
+const T &Vector<T, Allocator, GrowthPolicy>::at(size_t index) const {
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return this->array[index];
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T &Vector<T, Allocator, GrowthPolicy>::at(size_t index) {
+  if (index >= this->size) {
+    throw std::out_of_range("Invalid range of element");
+  }
+  return this->array[index];
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+const T &Vector<T, Allocator, GrowthPolicy>::unchecked(size_t index) const {
+  return this->array[index];
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T &Vector<T, Allocator, GrowthPolicy>::unchecked(size_t index) {
+  return this->array[index];
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+T *Vector<T, Allocator, GrowthPolicy>::data() {
+  return this->array;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+const T *Vector<T, Allocator, GrowthPolicy>::data() const {
+  return this->array;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t Vector<T, Allocator, GrowthPolicy>::getSize() const {
   return this->size;
 }
 
-template <typename T>
-size_t Vector<T>::getCapacity() const {
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t Vector<T, Allocator, GrowthPolicy>::getCapacity() const {
   return this->capacity;
 }
 
-template <typename T>
-T *Vector<T>::begin() {
+template <typename T, typename Allocator, typename GrowthPolicy>
+T *Vector<T, Allocator, GrowthPolicy>::begin() {
   return this->array;
 }
 
-template <typename T>
-T *Vector<T>::end() {
+template <typename T, typename Allocator, typename GrowthPolicy>
+T *Vector<T, Allocator, GrowthPolicy>::end() {
   return this->array + this->size;
 }
 
-template <typename T>
-const T *Vector<T>::begin() const {
+template <typename T, typename Allocator, typename GrowthPolicy>
+const T *Vector<T, Allocator, GrowthPolicy>::begin() const {
   return this->array;
 }
 
-template <typename T>
-const T *Vector<T>::end() const {
+template <typename T, typename Allocator, typename GrowthPolicy>
+const T *Vector<T, Allocator, GrowthPolicy>::end() const {
   return this->array + this->size;
 }
 
-template <typename S>
-std::ostream &operator<<(std::ostream &outputStream, const Vector<S> &vector) {
-  for (size_t i = 0; i < vector.size - 1; i++) {
-    outputStream << vector.array[i] << " ";
+template <typename T, typename Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::writeBinary(
+    std::ostream &outputStream) const
+  requires std::is_trivially_copyable_v<T>
+{
+  BinaryHeader header = BinaryHeader::describe(sizeof(T), this->size);
+  outputStream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  outputStream.write(reinterpret_cast<const char *>(this->array),
+                     static_cast<std::streamsize>(this->size * sizeof(T)));
+  if (!outputStream) {
+    throw std::runtime_error("Cannot write serialized Vector");
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy> Vector<T, Allocator, GrowthPolicy>::
+    readBinary(std::istream &inputStream, const Allocator &allocator)
+  requires std::is_trivially_copyable_v<T>
+{
+  BinaryHeader header;
+  if (!inputStream.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    throw std::runtime_error("Serialized Vector is truncated");
+  }
+  header.validate(sizeof(T));
+  // a crafted count must not wrap the byte count or outgrow the stream
+  if (header.count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+    throw std::runtime_error("Serialized Vector count is too large");
+  }
+  std::istream::pos_type payloadStart = inputStream.tellg();
+  if (payloadStart != std::istream::pos_type(-1)) {
+    inputStream.seekg(0, std::ios::end);
+    std::istream::pos_type payloadEnd = inputStream.tellg();
+    inputStream.clear();
+    inputStream.seekg(payloadStart);
+    if (payloadEnd != std::istream::pos_type(-1) &&
+        header.count > static_cast<uint64_t>(payloadEnd - payloadStart) /
+                           sizeof(T)) {
+      throw std::runtime_error("Serialized Vector is truncated");
+    }
+  }
+  // the payload is read straight into uninitialized storage in one call
+  Vector result(static_cast<size_t>(header.count), allocator);
+  std::streamsize bytes =
+      static_cast<std::streamsize>(header.count * sizeof(T));
+  if (!inputStream.read(reinterpret_cast<char *>(result.array), bytes)) {
+    throw std::runtime_error("Serialized Vector is truncated");
+  }
+  result.size = static_cast<size_t>(header.count);
+  return result;
+}
+
+template <typename S, typename A, typename G>
+std::ostream &operator<<(std::ostream &outputStream,
+                         const Vector<S, A, G> &vector) {
+  for (size_t i = 0; i < vector.size; i++) {
+    if (i > 0) {
+      outputStream << " ";
+    }
+    outputStream << vector.array[i];
   }
-  outputStream << vector.array[vector.size - 1];
   return outputStream;
 }
 
@@ -0,0 +1,86 @@
+#ifndef VECTOR_OPS_H
+#define VECTOR_OPS_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+
+#include "Vector.h"
+
+template <typename T>
+concept SimdArithmetic =
+    std::same_as<T, int32_t> || std::same_as<T, int64_t> ||
+    std::same_as<T, float> || std::same_as<T, double>;
+
+enum class SimdLevel { SCALAR, SSE42, AVX2 };
+
+// Bulk kernels over contiguous arrays. The instruction set is picked once at
+// runtime from what the CPU supports; setLevel() can lower it (tests and
+// benchmarks) and is not thread-safe.
+template <SimdArithmetic T>
+class VectorOps {
+ public:
+  static void fill(T *data, size_t size, T value);
+  static T sum(const T *data, size_t size);
+  static std::optional<T> min(const T *data, size_t size);
+  static std::optional<T> max(const T *data, size_t size);
+  static std::optional<size_t> find(const T *data, size_t size, T value);
+  static size_t count(const T *data, size_t size, T value);
+  static void add(T *data, const T *other, size_t size);
+  static void scale(T *data, size_t size, T factor);
+
+  static SimdLevel getLevel();
+  static SimdLevel setLevel(SimdLevel level);
+};
+
+extern template class VectorOps<int32_t>;
+extern template class VectorOps<int64_t>;
+extern template class VectorOps<float>;
+extern template class VectorOps<double>;
+
+template <SimdArithmetic T, typename A, typename G>
+void fill(Vector<T, A, G> &vector, T value) {
+  VectorOps<T>::fill(vector.data(), vector.getSize(), value);
+}
+
+template <SimdArithmetic T, typename A, typename G>
+T sum(const Vector<T, A, G> &vector) {
+  return VectorOps<T>::sum(vector.data(), vector.getSize());
+}
+
+template <SimdArithmetic T, typename A, typename G>
+std::optional<T> min(const Vector<T, A, G> &vector) {
+  return VectorOps<T>::min(vector.data(), vector.getSize());
+}
+
+template <SimdArithmetic T, typename A, typename G>
+std::optional<T> max(const Vector<T, A, G> &vector) {
+  return VectorOps<T>::max(vector.data(), vector.getSize());
+}
+
+template <SimdArithmetic T, typename A, typename G>
+std::optional<size_t> find(const Vector<T, A, G> &vector, T value) {
+  return VectorOps<T>::find(vector.data(), vector.getSize(), value);
+}
+
+template <SimdArithmetic T, typename A, typename G>
+size_t count(const Vector<T, A, G> &vector, T value) {
+  return VectorOps<T>::count(vector.data(), vector.getSize(), value);
+}
+
+template <SimdArithmetic T, typename A, typename G, typename B, typename H>
+void add(Vector<T, A, G> &vector, const Vector<T, B, H> &other) {
+  if (vector.getSize() != other.getSize()) {
+    throw std::invalid_argument("Vectors differ in size");
+  }
+  VectorOps<T>::add(vector.data(), other.data(), vector.getSize());
+}
+
+template <SimdArithmetic T, typename A, typename G>
+void scale(Vector<T, A, G> &vector, T factor) {
+  VectorOps<T>::scale(vector.data(), vector.getSize(), factor);
+}
+
+#endif  // !VECTOR_OPS_H
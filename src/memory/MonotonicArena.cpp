@@ -0,0 +1,69 @@
+#include "MonotonicArena.h"
+
+#include <algorithm>
+#include <memory>
+
+MonotonicArena::MonotonicArena(size_t initialChunkSize,
+                               std::pmr::memory_resource *upstream)
+    : upstream(upstream), nextChunkSize(initialChunkSize) {}
+
+MonotonicArena::MonotonicArena(void *buffer, size_t bufferSize,
+                               std::pmr::memory_resource *upstream)
+    : upstream(upstream),
+      current(static_cast<std::byte *>(buffer)),
+      remaining(bufferSize),
+      nextChunkSize(std::max<size_t>(bufferSize, 4096)),
+      initialBuffer(static_cast<std::byte *>(buffer)),
+      initialSize(bufferSize) {}
+
+MonotonicArena::~MonotonicArena() { release(); }
+
+void MonotonicArena::addChunk(size_t minimumBytes, size_t alignment) {
+  size_t size = std::max(nextChunkSize,
+                         sizeof(Chunk) + minimumBytes + alignment);
+  auto *chunk = static_cast<Chunk *>(
+      this->upstream->allocate(size, alignof(std::max_align_t)));
+  chunk->previous = this->chunks;
+  chunk->size = size;
+  this->chunks = chunk;
+  this->current = reinterpret_cast<std::byte *>(chunk + 1);
+  this->remaining = size - sizeof(Chunk);
+  this->nextChunkSize = 2 * size;
+}
+
+void *MonotonicArena::do_allocate(size_t bytes, size_t alignment) {
+  void *pointer = this->current;
+  if (std::align(alignment, bytes, pointer, this->remaining) == nullptr) {
+    addChunk(bytes, alignment);
+    pointer = this->current;
+    std::align(alignment, bytes, pointer, this->remaining);
+  }
+  this->current = static_cast<std::byte *>(pointer) + bytes;
+  this->remaining -= bytes;
+  this->bytesAllocated += bytes;
+  return pointer;
+}
+
+void MonotonicArena::do_deallocate(void * /*pointer*/, size_t /*bytes*/,
+                                   size_t /*alignment*/) {}
+
+bool MonotonicArena::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+void MonotonicArena::release() {
+  while (this->chunks != nullptr) {
+    Chunk *previous = this->chunks->previous;
+    this->upstream->deallocate(this->chunks, this->chunks->size,
+                               alignof(std::max_align_t));
+    this->chunks = previous;
+  }
+  this->current = this->initialBuffer;
+  this->remaining = this->initialSize;
+  this->bytesAllocated = 0;
+}
+
+size_t MonotonicArena::getBytesAllocated() const {
+  return this->bytesAllocated;
+}
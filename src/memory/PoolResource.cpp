@@ -0,0 +1,83 @@
+#include "PoolResource.h"
+
+#include <algorithm>
+
+namespace {
+constexpr size_t roundUp(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+constexpr size_t CHUNK_HEADER_SIZE = roundUp(
+    sizeof(void *), alignof(std::max_align_t));
+}  // namespace
+
+PoolResource::PoolResource(size_t blockSize, size_t blocksPerChunk,
+                           std::pmr::memory_resource *upstream)
+    : upstream(upstream),
+      blockSize(roundUp(std::max(blockSize, sizeof(FreeBlock)),
+                        alignof(std::max_align_t))),
+      blocksPerChunk(std::max<size_t>(blocksPerChunk, 1)) {}
+
+PoolResource::~PoolResource() { release(); }
+
+size_t PoolResource::chunkBytes() const {
+  return CHUNK_HEADER_SIZE + this->blockSize * this->blocksPerChunk;
+}
+
+bool PoolResource::fits(size_t bytes, size_t alignment) const {
+  return bytes <= this->blockSize && alignment <= alignof(std::max_align_t);
+}
+
+void PoolResource::addChunk() {
+  auto *chunk = static_cast<Chunk *>(
+      this->upstream->allocate(chunkBytes(), alignof(std::max_align_t)));
+  chunk->previous = this->chunks;
+  this->chunks = chunk;
+  std::byte *blocks = reinterpret_cast<std::byte *>(chunk) + CHUNK_HEADER_SIZE;
+  // thread the new blocks onto the free list, lowest address first
+  for (size_t i = this->blocksPerChunk; i > 0; i--) {
+    auto *block =
+        reinterpret_cast<FreeBlock *>(blocks + (i - 1) * this->blockSize);
+    block->next = this->freeList;
+    this->freeList = block;
+  }
+}
+
+void *PoolResource::do_allocate(size_t bytes, size_t alignment) {
+  if (!fits(bytes, alignment)) {
+    return this->upstream->allocate(bytes, alignment);
+  }
+  if (this->freeList == nullptr) {
+    addChunk();
+  }
+  FreeBlock *block = this->freeList;
+  this->freeList = block->next;
+  return block;
+}
+
+void PoolResource::do_deallocate(void *pointer, size_t bytes,
+                                 size_t alignment) {
+  if (!fits(bytes, alignment)) {
+    this->upstream->deallocate(pointer, bytes, alignment);
+    return;
+  }
+  auto *block = static_cast<FreeBlock *>(pointer);
+  block->next = this->freeList;
+  this->freeList = block;
+}
+
+bool PoolResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+void PoolResource::release() {
+  while (this->chunks != nullptr) {
+    Chunk *previous = this->chunks->previous;
+    this->upstream->deallocate(this->chunks, chunkBytes(),
+                               alignof(std::max_align_t));
+    this->chunks = previous;
+  }
+  this->freeList = nullptr;
+}
+
+size_t PoolResource::getBlockSize() const { return this->blockSize; }
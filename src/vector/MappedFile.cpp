@@ -0,0 +1,137 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+namespace {
+[[noreturn]] void throwSystemError(const char *what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+}  // namespace
+
+MappedFile::MappedFile(const std::string &path, Mode mode) : mode(mode) {
+  int flags = mode == Mode::READ_WRITE ? O_RDWR | O_CREAT : O_RDONLY;
+  this->descriptor = ::open(path.c_str(), flags, 0644);
+  if (this->descriptor < 0) {
+    throwSystemError("Cannot open mapped file");
+  }
+  struct stat status {};
+  if (::fstat(this->descriptor, &status) != 0) {
+    int error = errno;
+    close();
+    errno = error;
+    throwSystemError("Cannot stat mapped file");
+  }
+  try {
+    map(static_cast<size_t>(status.st_size));
+  } catch (...) {
+    close();
+    throw;
+  }
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : descriptor(std::exchange(other.descriptor, -1)),
+      mapping(std::exchange(other.mapping, nullptr)),
+      length(std::exchange(other.length, 0)),
+      mode(other.mode) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    close();
+    this->descriptor = std::exchange(other.descriptor, -1);
+    this->mapping = std::exchange(other.mapping, nullptr);
+    this->length = std::exchange(other.length, 0);
+    this->mode = other.mode;
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { close(); }
+
+void MappedFile::map(size_t newLength) {
+  this->length = newLength;
+  if (newLength == 0) {
+    // mmap rejects empty mappings, an empty file simply has no pages
+    return;
+  }
+  int protection = PROT_READ | PROT_WRITE;
+  int flags = MAP_SHARED;
+  if (this->mode == Mode::READ_ONLY) {
+    protection = PROT_READ;
+  } else if (this->mode == Mode::COPY_ON_WRITE) {
+    // a private writable mapping is otherwise charged in full against the
+    // commit limit, which a file larger than RAM plus swap cannot pass;
+    // only the pages actually written take memory
+    flags = MAP_PRIVATE | MAP_NORESERVE;
+  }
+  void *address =
+      ::mmap(nullptr, newLength, protection, flags, this->descriptor, 0);
+  if (address == MAP_FAILED) {
+    this->length = 0;
+    throwSystemError("Cannot map file");
+  }
+  this->mapping = static_cast<std::byte *>(address);
+}
+
+void MappedFile::unmap() {
+  if (this->mapping != nullptr) {
+    ::munmap(this->mapping, this->length);
+  }
+  this->mapping = nullptr;
+  this->length = 0;
+}
+
+void MappedFile::close() {
+  unmap();
+  if (this->descriptor >= 0) {
+    ::close(this->descriptor);
+  }
+  this->descriptor = -1;
+}
+
+void MappedFile::resize(size_t newLength) {
+  if (this->mode != Mode::READ_WRITE) {
+    throw std::system_error(EBADF, std::generic_category(),
+                            "Cannot resize a read-only mapped file");
+  }
+  if (::ftruncate(this->descriptor, static_cast<off_t>(newLength)) != 0) {
+    throwSystemError("Cannot resize mapped file");
+  }
+#ifdef __linux__
+  if (this->mapping != nullptr && newLength > 0) {
+    // the kernel can move the pages without tearing the mapping down
+    void *address =
+        ::mremap(this->mapping, this->length, newLength, MREMAP_MAYMOVE);
+    if (address == MAP_FAILED) {
+      throwSystemError("Cannot remap file");
+    }
+    this->mapping = static_cast<std::byte *>(address);
+    this->length = newLength;
+    return;
+  }
+#endif
+  unmap();
+  map(newLength);
+}
+
+void MappedFile::sync(size_t byteCount) const {
+  if (this->mapping == nullptr || byteCount == 0) {
+    return;
+  }
+  if (::msync(this->mapping, byteCount, MS_SYNC) != 0) {
+    throwSystemError("Cannot sync mapped file");
+  }
+}
+
+std::byte *MappedFile::data() const { return this->mapping; }
+
+size_t MappedFile::getLength() const { return this->length; }
+
+MappedFile::Mode MappedFile::getMode() const { return this->mode; }
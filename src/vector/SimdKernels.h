@@ -0,0 +1,204 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstring>
+
+// Kernel set of one instruction set, filled in by the VectorOps*.cpp files.
+// min and max expect size > 0, find returns size when the value is missing.
+template <typename T>
+struct KernelTable {
+  void (*fill)(T *data, size_t size, T value);
+  T (*sum)(const T *data, size_t size);
+  T (*min)(const T *data, size_t size);
+  T (*max)(const T *data, size_t size);
+  size_t (*find)(const T *data, size_t size, T value);
+  size_t (*count)(const T *data, size_t size, T value);
+  void (*add)(T *data, const T *other, size_t size);
+  void (*scale)(T *data, size_t size, T factor);
+};
+
+template <typename T>
+KernelTable<T> scalarKernels();
+template <typename T>
+KernelTable<T> sse42Kernels();
+template <typename T>
+KernelTable<T> avx2Kernels();
+
+// The kernels below are written once with GCC/Clang vector extensions and
+// compiled per instruction set. They live in an anonymous namespace so each
+// translation unit keeps its own copy, built with its own target flags.
+namespace {
+
+template <typename T, size_t Bytes>
+struct Lanes {
+  typedef T Vec __attribute__((vector_size(Bytes)));
+  using Mask = decltype(Vec{} == Vec{});
+  static constexpr size_t WIDTH = Bytes / sizeof(T);
+
+  static Vec load(const T *data) {
+    Vec vec;
+    std::memcpy(&vec, data, sizeof(Vec));
+    return vec;
+  }
+  static void store(T *data, Vec vec) { std::memcpy(data, &vec, sizeof(Vec)); }
+  static Vec broadcast(T value) { return Vec{} + value; }
+  static bool any(Mask mask) {
+    for (size_t lane = 0; lane < WIDTH; lane++) {
+      if (mask[lane] != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+template <typename T, size_t Bytes>
+void simdFill(T *data, size_t size, T value) {
+  using L = Lanes<T, Bytes>;
+  typename L::Vec vec = L::broadcast(value);
+  size_t i = 0;
+  for (; i + L::WIDTH <= size; i += L::WIDTH) {
+    L::store(data + i, vec);
+  }
+  for (; i < size; i++) {
+    data[i] = value;
+  }
+}
+
+template <typename T, size_t Bytes>
+T simdSum(const T *data, size_t size) {
+  using L = Lanes<T, Bytes>;
+  // independent accumulators hide the latency of the adds
+  typename L::Vec acc0{}, acc1{}, acc2{}, acc3{};
+  size_t i = 0;
+  for (; i + 4 * L::WIDTH <= size; i += 4 * L::WIDTH) {
+    acc0 += L::load(data + i);
+    acc1 += L::load(data + i + L::WIDTH);
+    acc2 += L::load(data + i + 2 * L::WIDTH);
+    acc3 += L::load(data + i + 3 * L::WIDTH);
+  }
+  for (; i + L::WIDTH <= size; i += L::WIDTH) {
+    acc0 += L::load(data + i);
+  }
+  typename L::Vec acc = (acc0 + acc1) + (acc2 + acc3);
+  T result = 0;
+  for (size_t lane = 0; lane < L::WIDTH; lane++) {
+    result += acc[lane];
+  }
+  for (; i < size; i++) {
+    result += data[i];
+  }
+  return result;
+}
+
+template <typename T, size_t Bytes, bool Minimum>
+T simdExtreme(const T *data, size_t size) {
+  using L = Lanes<T, Bytes>;
+  T result = data[0];
+  size_t i = 0;
+  if (size >= L::WIDTH) {
+    typename L::Vec acc = L::load(data);
+    for (i = L::WIDTH; i + L::WIDTH <= size; i += L::WIDTH) {
+      typename L::Vec vec = L::load(data + i);
+      if constexpr (Minimum) {
+        acc = vec < acc ? vec : acc;
+      } else {
+        acc = vec > acc ? vec : acc;
+      }
+    }
+    for (size_t lane = 0; lane < L::WIDTH; lane++) {
+      result = (Minimum ? acc[lane] < result : acc[lane] > result) ? acc[lane]
+                                                                  : result;
+    }
+  }
+  for (; i < size; i++) {
+    result = (Minimum ? data[i] < result : data[i] > result) ? data[i] : result;
+  }
+  return result;
+}
+
+template <typename T, size_t Bytes>
+size_t simdFind(const T *data, size_t size, T value) {
+  using L = Lanes<T, Bytes>;
+  typename L::Vec key = L::broadcast(value);
+  size_t i = 0;
+  for (; i + L::WIDTH <= size; i += L::WIDTH) {
+    typename L::Mask mask = L::load(data + i) == key;
+    if (L::any(mask)) {
+      for (size_t lane = 0; lane < L::WIDTH; lane++) {
+        if (mask[lane] != 0) {
+          return i + lane;
+        }
+      }
+    }
+  }
+  for (; i < size; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <typename T, size_t Bytes>
+size_t simdCount(const T *data, size_t size, T value) {
+  using L = Lanes<T, Bytes>;
+  // matching lanes compare to -1, so subtracting the mask counts them; flush
+  // before the narrow lane counters of float masks can overflow
+  constexpr size_t FLUSH_BLOCKS = 1 << 20;
+  typename L::Vec key = L::broadcast(value);
+  size_t result = 0;
+  size_t i = 0;
+  while (i + L::WIDTH <= size) {
+    typename L::Mask counters{};
+    for (size_t blocks = 0; blocks < FLUSH_BLOCKS && i + L::WIDTH <= size;
+         blocks++, i += L::WIDTH) {
+      counters -= L::load(data + i) == key;
+    }
+    for (size_t lane = 0; lane < L::WIDTH; lane++) {
+      result += counters[lane];
+    }
+  }
+  for (; i < size; i++) {
+    result += data[i] == value ? 1 : 0;
+  }
+  return result;
+}
+
+template <typename T, size_t Bytes>
+void simdAdd(T *data, const T *other, size_t size) {
+  using L = Lanes<T, Bytes>;
+  size_t i = 0;
+  for (; i + L::WIDTH <= size; i += L::WIDTH) {
+    L::store(data + i, L::load(data + i) + L::load(other + i));
+  }
+  for (; i < size; i++) {
+    data[i] += other[i];
+  }
+}
+
+template <typename T, size_t Bytes>
+void simdScale(T *data, size_t size, T factor) {
+  using L = Lanes<T, Bytes>;
+  typename L::Vec vec = L::broadcast(factor);
+  size_t i = 0;
+  for (; i + L::WIDTH <= size; i += L::WIDTH) {
+    L::store(data + i, L::load(data + i) * vec);
+  }
+  for (; i < size; i++) {
+    data[i] *= factor;
+  }
+}
+
+template <typename T, size_t Bytes>
+KernelTable<T> makeSimdKernels() {
+  return {&simdFill<T, Bytes>,          &simdSum<T, Bytes>,
+          &simdExtreme<T, Bytes, true>, &simdExtreme<T, Bytes, false>,
+          &simdFind<T, Bytes>,          &simdCount<T, Bytes>,
+          &simdAdd<T, Bytes>,           &simdScale<T, Bytes>};
+}
+
+}  // namespace
+
+#endif  // !SIMD_KERNELS_H
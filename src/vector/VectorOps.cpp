@@ -0,0 +1,189 @@
+#include "VectorOps.h"
+
+#include <algorithm>
+
+#include "SimdKernels.h"
+
+namespace {
+
+template <typename T>
+void scalarFill(T *data, size_t size, T value) {
+  for (size_t i = 0; i < size; i++) {
+    data[i] = value;
+  }
+}
+
+template <typename T>
+T scalarSum(const T *data, size_t size) {
+  T result = 0;
+  for (size_t i = 0; i < size; i++) {
+    result += data[i];
+  }
+  return result;
+}
+
+template <typename T>
+T scalarMin(const T *data, size_t size) {
+  T result = data[0];
+  for (size_t i = 1; i < size; i++) {
+    result = data[i] < result ? data[i] : result;
+  }
+  return result;
+}
+
+template <typename T>
+T scalarMax(const T *data, size_t size) {
+  T result = data[0];
+  for (size_t i = 1; i < size; i++) {
+    result = data[i] > result ? data[i] : result;
+  }
+  return result;
+}
+
+template <typename T>
+size_t scalarFind(const T *data, size_t size, T value) {
+  for (size_t i = 0; i < size; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <typename T>
+size_t scalarCount(const T *data, size_t size, T value) {
+  size_t result = 0;
+  for (size_t i = 0; i < size; i++) {
+    result += data[i] == value ? 1 : 0;
+  }
+  return result;
+}
+
+template <typename T>
+void scalarAdd(T *data, const T *other, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    data[i] += other[i];
+  }
+}
+
+template <typename T>
+void scalarScale(T *data, size_t size, T factor) {
+  for (size_t i = 0; i < size; i++) {
+    data[i] *= factor;
+  }
+}
+
+SimdLevel supportedLevel() {
+#ifdef VECTOR_OPS_X86
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return SimdLevel::SSE42;
+  }
+#endif
+  return SimdLevel::SCALAR;
+}
+
+template <typename T>
+KernelTable<T> kernelsFor(SimdLevel level) {
+  switch (level) {
+#ifdef VECTOR_OPS_X86
+    case SimdLevel::AVX2:
+      return avx2Kernels<T>();
+    case SimdLevel::SSE42:
+      return sse42Kernels<T>();
+#endif
+    default:
+      return scalarKernels<T>();
+  }
+}
+
+template <typename T>
+struct ActiveKernels {
+  SimdLevel level = supportedLevel();
+  KernelTable<T> table = kernelsFor<T>(level);
+};
+
+template <typename T>
+ActiveKernels<T> &active() {
+  static ActiveKernels<T> kernels;
+  return kernels;
+}
+
+}  // namespace
+
+template <typename T>
+KernelTable<T> scalarKernels() {
+  return {&scalarFill<T>, &scalarSum<T>,   &scalarMin<T>, &scalarMax<T>,
+          &scalarFind<T>, &scalarCount<T>, &scalarAdd<T>, &scalarScale<T>};
+}
+
+template <SimdArithmetic T>
+void VectorOps<T>::fill(T *data, size_t size, T value) {
+  active<T>().table.fill(data, size, value);
+}
+
+template <SimdArithmetic T>
+T VectorOps<T>::sum(const T *data, size_t size) {
+  return active<T>().table.sum(data, size);
+}
+
+template <SimdArithmetic T>
+std::optional<T> VectorOps<T>::min(const T *data, size_t size) {
+  if (size == 0) {
+    return {};
+  }
+  return active<T>().table.min(data, size);
+}
+
+template <SimdArithmetic T>
+std::optional<T> VectorOps<T>::max(const T *data, size_t size) {
+  if (size == 0) {
+    return {};
+  }
+  return active<T>().table.max(data, size);
+}
+
+template <SimdArithmetic T>
+std::optional<size_t> VectorOps<T>::find(const T *data, size_t size,
+                                         T value) {
+  size_t index = active<T>().table.find(data, size, value);
+  if (index == size) {
+    return {};
+  }
+  return index;
+}
+
+template <SimdArithmetic T>
+size_t VectorOps<T>::count(const T *data, size_t size, T value) {
+  return active<T>().table.count(data, size, value);
+}
+
+template <SimdArithmetic T>
+void VectorOps<T>::add(T *data, const T *other, size_t size) {
+  active<T>().table.add(data, other, size);
+}
+
+template <SimdArithmetic T>
+void VectorOps<T>::scale(T *data, size_t size, T factor) {
+  active<T>().table.scale(data, size, factor);
+}
+
+template <SimdArithmetic T>
+SimdLevel VectorOps<T>::getLevel() {
+  return active<T>().level;
+}
+
+template <SimdArithmetic T>
+SimdLevel VectorOps<T>::setLevel(SimdLevel level) {
+  level = std::min(level, supportedLevel());
+  active<T>().level = level;
+  active<T>().table = kernelsFor<T>(level);
+  return level;
+}
+
+template class VectorOps<int32_t>;
+template class VectorOps<int64_t>;
+template class VectorOps<float>;
+template class VectorOps<double>;
@@ -0,0 +1,14 @@
+// Compiled with -mavx2
+#include <cstdint>
+
+#include "SimdKernels.h"
+
+template <typename T>
+KernelTable<T> avx2Kernels() {
+  return makeSimdKernels<T, 32>();
+}
+
+template KernelTable<int32_t> avx2Kernels<int32_t>();
+template KernelTable<int64_t> avx2Kernels<int64_t>();
+template KernelTable<float> avx2Kernels<float>();
+template KernelTable<double> avx2Kernels<double>();
@@ -0,0 +1,14 @@
+// Compiled with -msse4.2
+#include <cstdint>
+
+#include "SimdKernels.h"
+
+template <typename T>
+KernelTable<T> sse42Kernels() {
+  return makeSimdKernels<T, 16>();
+}
+
+template KernelTable<int32_t> sse42Kernels<int32_t>();
+template KernelTable<int64_t> sse42Kernels<int64_t>();
+template KernelTable<float> sse42Kernels<float>();
+template KernelTable<double> sse42Kernels<double>();
@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#define CATCH_CONFIG_MAIN
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "MappedVector.h"
+#include "Searching.h"
+
+template <typename V>
+concept CanPushBack = requires(V &vector) { vector.pushBack(1); };
+
+template <typename V>
+concept CanAssign = requires(V &vector) { vector[0] = 1; };
+
+TEST_CASE("MappedVector tests") {
+  using Mode = MappedFile::Mode;
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "TestMappedVector.bin";
+  std::filesystem::remove(path);
+
+  SECTION("Opening a missing file for writing creates an empty vector") {
+    MappedVector<int64_t, Mode::READ_WRITE> vector(path.string());
+    REQUIRE(vector.getSize() == 0);
+    REQUIRE(vector.begin() == vector.end());
+    REQUIRE_THROWS_AS(vector[0], std::out_of_range);
+  }
+
+  SECTION("Opening a missing file read-only throws") {
+    REQUIRE_THROWS_AS(MappedVector<int>(path.string()), std::system_error);
+  }
+
+  SECTION("Appended elements are in the file after reopening") {
+    {
+      MappedVector<int64_t, Mode::READ_WRITE> vector(path.string());
+      for (int64_t i = 0; i < 10000; i++) {
+        vector.pushBack(i * i);
+      }
+      REQUIRE(vector.getCapacity() >= 10000);
+      vector.sync();
+    }
+    REQUIRE(std::filesystem::file_size(path) == 10000 * sizeof(int64_t));
+
+    const MappedVector<int64_t> vector(path.string());
+    REQUIRE(vector.isReadOnly());
+    REQUIRE(vector.getSize() == 10000);
+    for (int64_t i = 0; i < 10000; i++) {
+      CAPTURE(i);
+      CHECK(vector[i] == i * i);
+    }
+  }
+
+  SECTION("Pushing back an element of the mapping survives the remap") {
+    MappedVector<int, Mode::READ_WRITE> vector(path.string());
+    vector.pushBack(7);
+    size_t capacity = vector.getCapacity();
+    for (size_t i = 1; i < capacity; i++) {
+      vector.pushBack(1);
+    }
+    vector.pushBack(vector[0]);
+    REQUIRE(vector.getCapacity() > capacity);
+    REQUIRE(vector[capacity] == 7);
+  }
+
+  SECTION("Read-only vectors only hand out const elements") {
+    std::ofstream(path, std::ios::binary) << "abcdefgh";
+    MappedVector<int> vector(path.string());
+    REQUIRE(vector.isReadOnly());
+    REQUIRE(vector.getSize() == 2);
+    REQUIRE(vector[1] == vector.begin()[1]);
+    REQUIRE(lowerBound(vector, vector[1]) == vector.begin() + 1);
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(std::declval<MappedVector<int> &>().begin()),
+                       const int *>);
+    STATIC_REQUIRE_FALSE(CanPushBack<MappedVector<int>>);
+    STATIC_REQUIRE_FALSE(CanAssign<MappedVector<int>>);
+    STATIC_REQUIRE_FALSE(
+        CanPushBack<MappedVector<int, Mode::COPY_ON_WRITE>>);
+    STATIC_REQUIRE(CanAssign<MappedVector<int, Mode::COPY_ON_WRITE>>);
+    STATIC_REQUIRE(CanPushBack<MappedVector<int, Mode::READ_WRITE>>);
+  }
+
+  SECTION("Copy-on-write vectors are sorted in memory, not in the file") {
+    {
+      MappedVector<int, Mode::READ_WRITE> vector(path.string());
+      for (int i = 0; i < 1000; i++) {
+        vector.pushBack(999 - i);
+      }
+    }
+    MappedVector<int, Mode::COPY_ON_WRITE> vector(path.string());
+    REQUIRE_FALSE(vector.isReadOnly());
+    REQUIRE(*std::lower_bound(vector.begin(), vector.end(), 500,
+                              std::greater<>()) == 500);
+    std::sort(vector.begin(), vector.end());
+    REQUIRE(std::is_sorted(vector.begin(), vector.end()));
+    REQUIRE(vector[0] == 0);
+    const MappedVector<int> reopened(path.string());
+    REQUIRE(reopened[0] == 999);
+    REQUIRE(std::filesystem::file_size(path) == 1000 * sizeof(int));
+  }
+
+  SECTION("Sparse files larger than memory are mapped") {
+    // big enough to need paging on a test machine, small enough for common
+    // file size limits; where the system refuses, the section is skipped
+    constexpr uintmax_t length = uintmax_t(8) << 30;
+    std::ofstream(path, std::ios::binary);
+    std::error_code error;
+    std::filesystem::resize_file(path, length, error);
+    if (error) {
+      WARN("Skipped, cannot create a sparse file: " << error.message());
+    } else {
+      try {
+        {
+          const MappedVector<uint64_t> vector(path.string());
+          REQUIRE(vector.getSize() == length / sizeof(uint64_t));
+          REQUIRE(vector[vector.getSize() - 1] == 0);
+        }
+        MappedVector<uint64_t, Mode::COPY_ON_WRITE> vector(path.string());
+        vector[vector.getSize() - 1] = 5;
+        REQUIRE(vector[vector.getSize() - 1] == 5);
+        const MappedVector<uint64_t> reopened(path.string());
+        REQUIRE(reopened[reopened.getSize() - 1] == 0);
+      } catch (const std::system_error &mapError) {
+        if (mapError.code() != std::errc::not_enough_memory) {
+          throw;
+        }
+        WARN("Skipped, cannot map the file: " << mapError.what());
+      }
+    }
+  }
+
+  SECTION("Files that do not hold whole elements are rejected") {
+    std::ofstream(path, std::ios::binary) << "abc";
+    REQUIRE_THROWS_AS(MappedVector<int>(path.string()), std::runtime_error);
+  }
+
+  SECTION("Standard algorithms run over the mapping") {
+    MappedVector<int, Mode::READ_WRITE> vector(path.string());
+    for (int i = 0; i < 1000; i++) {
+      vector.pushBack((i * 7919) % 1000);
+    }
+    std::sort(vector.begin(), vector.end());
+    REQUIRE(std::is_sorted(vector.begin(), vector.end()));
+    REQUIRE(*std::lower_bound(vector.begin(), vector.end(), 500) == 500);
+  }
+
+  SECTION("Moving transfers the mapping") {
+    MappedVector<int, Mode::READ_WRITE> vector(path.string());
+    vector.pushBack(3);
+    MappedVector<int, Mode::READ_WRITE> moved(std::move(vector));
+    REQUIRE(moved.getSize() == 1);
+    REQUIRE(moved[0] == 3);
+    REQUIRE(vector.getSize() == 0);
+  }
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+#define CATCH_CONFIG_MAIN
+#include <cstdint>
+#include <memory_resource>
+
+#include "Avl.h"
+#include "BinaryTree.h"
+#include "DoublyLinkedList.h"
+#include "MonotonicArena.h"
+#include "PoolResource.h"
+#include "SinglyLinkedList.h"
+#include "Vector.h"
+
+namespace {
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  size_t deallocations = 0;
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+    deallocations++;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+template <typename T>
+using PmrAllocator = std::pmr::polymorphic_allocator<T>;
+
+// an ordered value that counts how often it was copied
+struct Tracked {
+  static inline int copies = 0;
+  int key;
+
+  Tracked(int key) : key(key) {}
+  Tracked(const Tracked &other) : key(other.key) { copies++; }
+  Tracked(Tracked &&other) noexcept = default;
+  Tracked &operator=(const Tracked &other) = default;
+  auto operator<=>(const Tracked &other) const = default;
+};
+}  // namespace
+
+TEST_CASE("Memory resource tests") {
+  CountingResource upstream;
+
+  SECTION("Arena hands out aligned memory and releases it at once") {
+    MonotonicArena arena(256, &upstream);
+    void *first = arena.allocate(3, 1);
+    void *second = arena.allocate(sizeof(double), alignof(double));
+    REQUIRE(first != second);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(second) % alignof(double) == 0);
+    REQUIRE(arena.allocate(4096, 64) != nullptr);
+    REQUIRE(upstream.allocations == 2);
+    REQUIRE(arena.getBytesAllocated() == 3 + sizeof(double) + 4096);
+    arena.release();
+    REQUIRE(upstream.deallocations == 2);
+    REQUIRE(arena.getBytesAllocated() == 0);
+  }
+
+  SECTION("Arena uses the initial buffer before going upstream") {
+    alignas(std::max_align_t) std::byte buffer[512];
+    MonotonicArena arena(buffer, sizeof(buffer), &upstream);
+    void *pointer = arena.allocate(128, 8);
+    REQUIRE(pointer >= static_cast<void *>(buffer));
+    REQUIRE(pointer < static_cast<void *>(buffer + sizeof(buffer)));
+    REQUIRE(upstream.allocations == 0);
+  }
+
+  SECTION("Pool reuses freed blocks and forwards oversized requests") {
+    PoolResource pool(24, 8, &upstream);
+    void *block = pool.allocate(24, 8);
+    pool.deallocate(block, 24, 8);
+    REQUIRE(pool.allocate(16, 8) == block);
+    for (int i = 0; i < 7; ++i) {
+      REQUIRE(pool.allocate(24, 8) != nullptr);
+    }
+    REQUIRE(upstream.allocations == 1);
+    void *large = pool.allocate(1024, 8);
+    REQUIRE(upstream.allocations == 2);
+    pool.deallocate(large, 1024, 8);
+    REQUIRE(upstream.deallocations == 1);
+  }
+
+  SECTION("Vector allocates from the arena") {
+    MonotonicArena arena(1024, &upstream);
+    Vector<int, PmrAllocator<int>> vector(&arena);
+    for (int i = 0; i < 100; ++i) {
+      vector.pushBack(i);
+    }
+    REQUIRE(vector.getAllocator().resource() == &arena);
+    REQUIRE(arena.getBytesAllocated() >= 100 * sizeof(int));
+    REQUIRE(vector[99] == 99);
+  }
+
+  SECTION("Vector move between resources moves the elements") {
+    MonotonicArena first(1024, &upstream);
+    MonotonicArena second(1024, &upstream);
+    Vector<int, PmrAllocator<int>> source({1, 2, 3}, &first);
+    Vector<int, PmrAllocator<int>> destination(&second);
+    destination = std::move(source);
+    REQUIRE(destination.getAllocator().resource() == &second);
+    REQUIRE(destination.getSize() == 3);
+    REQUIRE(destination[2] == 3);
+  }
+
+  SECTION("Lists allocate their nodes from the pool") {
+    PoolResource pool(64, 16, &upstream);
+    SinglyLinkedList<int, PmrAllocator<int>> singly(&pool);
+    DoublyLinkedList<int, PmrAllocator<int>> doubly(&pool);
+    for (int i = 0; i < 8; ++i) {
+      singly.pushBack(i);
+      doubly.pushFront(i);
+    }
+    REQUIRE(upstream.allocations == 1);
+    singly.erase(3);
+    doubly.popBack();
+    singly.pushFront(10);
+    doubly.pushBack(10);
+    REQUIRE(upstream.allocations == 1);
+    REQUIRE(singly[0] == 10);
+    REQUIRE(doubly[7] == 10);
+  }
+
+  SECTION("List copies keep the default allocator and moves keep elements") {
+    MonotonicArena arena(1024, &upstream);
+    DoublyLinkedList<int, PmrAllocator<int>> list({1, 2, 3}, &arena);
+    DoublyLinkedList<int, PmrAllocator<int>> copy(list);
+    REQUIRE(copy.getAllocator().resource() == std::pmr::get_default_resource());
+    SinglyLinkedList<int, PmrAllocator<int>> source({4, 5}, &arena);
+    SinglyLinkedList<int, PmrAllocator<int>> destination;
+    destination = std::move(source);
+    REQUIRE(destination.getSize() == 2);
+    REQUIRE(destination[1] == 5);
+    REQUIRE(source.getSize() == 0);
+  }
+
+  SECTION("Trees allocate their nodes from the arena") {
+    MonotonicArena arena(4096, &upstream);
+    BinaryTree<int, PmrAllocator<int>> binaryTree(&arena);
+    AVLTree<int, PmrAllocator<int>> avlTree(&arena);
+    for (int value : {5, 3, 8, 1, 4}) {
+      binaryTree.insert(value);
+      avlTree.insert(value);
+    }
+    binaryTree.remove(3);
+    avlTree.remove(3);
+    REQUIRE(upstream.allocations == 1);
+    REQUIRE(binaryTree.getElements() == std::vector<int>{1, 4, 5, 8});
+    REQUIRE(avlTree.getElements() == std::vector<int>{1, 4, 5, 8});
+    REQUIRE(avlTree.isBalanced());
+
+    AVLTree<int, PmrAllocator<int>> moved;
+    moved = std::move(avlTree);
+    REQUIRE(moved.getElements() == std::vector<int>{1, 4, 5, 8});
+  }
+
+  SECTION("Moves between unequal resources move the values") {
+    MonotonicArena first(4096, &upstream);
+    MonotonicArena second(4096, &upstream);
+    SinglyLinkedList<Tracked, PmrAllocator<Tracked>> singly(&first);
+    DoublyLinkedList<Tracked, PmrAllocator<Tracked>> doubly(&first);
+    BinaryTree<Tracked, PmrAllocator<Tracked>> binaryTree(&first);
+    AVLTree<Tracked, PmrAllocator<Tracked>> avlTree(&first);
+    for (int key : {5, 3, 8, 1, 4, 9, 7}) {
+      singly.pushBack(key);
+      doubly.pushBack(key);
+      binaryTree.insert(key);
+      avlTree.insert(key);
+    }
+    SinglyLinkedList<Tracked, PmrAllocator<Tracked>> singlyMoved(&second);
+    DoublyLinkedList<Tracked, PmrAllocator<Tracked>> doublyMoved(&second);
+    BinaryTree<Tracked, PmrAllocator<Tracked>> binaryTreeMoved(&second);
+    AVLTree<Tracked, PmrAllocator<Tracked>> avlTreeMoved(&second);
+    Tracked::copies = 0;
+    singlyMoved = std::move(singly);
+    doublyMoved = std::move(doubly);
+    binaryTreeMoved = std::move(binaryTree);
+    avlTreeMoved = std::move(avlTree);
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(singlyMoved.getSize() == 7);
+    REQUIRE(singlyMoved[6].key == 7);
+    REQUIRE(doublyMoved[0].key == 5);
+    REQUIRE(doublyMoved[6].key == 7);
+    REQUIRE(avlTreeMoved.isBalanced());
+    REQUIRE(avlTreeMoved.getElements().front().key == 1);
+    REQUIRE(binaryTreeMoved.getElements().back().key == 9);
+  }
+}
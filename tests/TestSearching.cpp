@@ -0,0 +1,437 @@
+#include <catch2/catch_test_macros.hpp>
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_template_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "LearnedIndex.h"
+#include "Searching.h"
+#include "StaticSearchIndex.h"
+#include "Vector.h"
+
+namespace {
+// sorted keys with runs of duplicates and gaps between them
+std::vector<int> sortedKeys(size_t size) {
+  std::mt19937 generator(17);
+  std::vector<int> keys(size);
+  for (int &key : keys) {
+    key = static_cast<int>(generator() % (size + 1)) * 2;
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+}  // namespace
+
+TEST_CASE("Bound searching tests") {
+  SECTION("Bounds match the standard library for every probe") {
+    for (size_t size : {0, 1, 2, 3, 7, 8, 100, 1025}) {
+      std::vector<int> keys = sortedKeys(size);
+      for (int probe = -1; probe <= static_cast<int>(2 * size + 3); probe++) {
+        CAPTURE(size, probe);
+        CHECK(lowerBound(keys.begin(), keys.end(), probe) ==
+              std::lower_bound(keys.begin(), keys.end(), probe));
+        CHECK(upperBound(keys.begin(), keys.end(), probe) ==
+              std::upper_bound(keys.begin(), keys.end(), probe));
+        CHECK(equalRange(keys, probe) ==
+              std::equal_range(keys.begin(), keys.end(), probe));
+      }
+    }
+  }
+
+  SECTION("Bounds take comparators and projections") {
+    std::vector<int> descending = {9, 7, 7, 7, 4, 1};
+    auto [lower, upper] = equalRange(descending, 7, std::greater<>());
+    REQUIRE(lower - descending.begin() == 1);
+    REQUIRE(upper - descending.begin() == 4);
+
+    std::vector<std::pair<std::string, int>> records = {
+        {"ann", 19}, {"bob", 25}, {"cid", 25}, {"dan", 31}};
+    auto found = lowerBound(records, 25, std::ranges::less(),
+                            &std::pair<std::string, int>::second);
+    REQUIRE(found->first == "bob");
+    REQUIRE(upperBound(records, 25, std::ranges::less(),
+                       &std::pair<std::string, int>::second)
+                ->first == "dan");
+  }
+
+  SECTION("Bounds work on Vector and raw pointers") {
+    Vector<double> vector = {0.5, 1.5, 1.5, 2.5};
+    REQUIRE(lowerBound(vector, 1.5) - vector.begin() == 1);
+    REQUIRE(upperBound(vector, 1.5) - vector.begin() == 3);
+    const int array[] = {1, 3, 5};
+    REQUIRE(lowerBound(array, array + 3, 4) == array + 2);
+  }
+
+  SECTION("Bounds take spans and views as temporaries") {
+    std::vector<int> keys = {1, 3, 3, 5, 8};
+    REQUIRE(lowerBound(std::span(keys), 3) - std::span(keys).begin() == 1);
+    REQUIRE(*upperBound(std::views::all(keys), 3) == 5);
+    auto [lower, upper] = equalRange(std::span(keys).subspan(1), 3);
+    REQUIRE(upper - lower == 2);
+    // views that own their state are searched as lvalues, so the result
+    // cannot dangle
+    auto doubled = keys |
+                   std::views::transform([](int key) { return 2 * key; }) |
+                   std::views::drop(1);
+    REQUIRE(*lowerBound(doubled, 7) == 10);
+  }
+
+  SECTION("Binary search finds every key and rejects the others") {
+    std::vector<int> keys = sortedKeys(500);
+    for (int probe = -3; probe < 1005; probe++) {
+      CAPTURE(probe);
+      std::optional<size_t> index = binarySearch(keys, probe, 0, 499);
+      bool present = std::binary_search(keys.begin(), keys.end(), probe);
+      CHECK(index.has_value() == present);
+      CHECK((!index || keys[*index] == probe));
+    }
+    REQUIRE_FALSE(binarySearch(std::vector<int>(), 1, 0, 0).has_value());
+    std::vector<int> small = {1, 3, 5, 7};
+    REQUIRE(binarySearch(small, 5, 1, 3) == std::optional<size_t>(2));
+    REQUIRE_FALSE(binarySearch(small, 1, 1, 3).has_value());
+  }
+}
+
+TEST_CASE("Classic searching tests") {
+  auto checkSearch = [](const std::vector<int> &keys, auto search) {
+    for (int probe = -3; probe < static_cast<int>(2 * keys.size() + 5);
+         probe++) {
+      CAPTURE(keys.size(), probe);
+      std::optional<size_t> index = search(keys, probe);
+      bool present = std::binary_search(keys.begin(), keys.end(), probe);
+      CHECK(index.has_value() == present);
+      CHECK((!index || keys[*index] == probe));
+    }
+  };
+
+  SECTION("Jump search stays inside the array") {
+    for (size_t size : {0, 1, 2, 3, 4, 5, 9, 10, 99, 100, 101}) {
+      std::vector<int> keys = sortedKeys(size);
+      checkSearch(keys, [](const auto &keys, int probe) {
+        return jumpSearch(keys, probe);
+      });
+    }
+    std::vector<int> distinct = {1, 3, 5, 7, 9, 11, 13, 15, 17};
+    REQUIRE(jumpSearch(distinct, 11) == std::optional<size_t>(5));
+    REQUIRE_FALSE(jumpSearch(distinct, 18).has_value());
+  }
+
+  SECTION("Exponential search finds keys from any hint") {
+    for (size_t size : {0, 1, 2, 7, 64, 1000}) {
+      std::vector<int> keys = sortedKeys(size);
+      for (size_t hint : {size_t(0), size / 3, size, size + 10}) {
+        CAPTURE(hint);
+        checkSearch(keys, [hint](const auto &keys, int probe) {
+          return exponentialSearch(keys, probe, hint);
+        });
+      }
+    }
+  }
+
+  SECTION("Exponential bounds take unbounded prefixes") {
+    std::vector<int> keys = sortedKeys(1000);
+    auto squares = std::views::iota(int64_t(0)) |
+                   std::views::transform([](int64_t i) { return i * i; });
+    for (int probe = -1; probe <= keys.back() + 1; probe++) {
+      CAPTURE(probe);
+      CHECK(exponentialLowerBound(keys.begin(), keys.end(), probe) ==
+            std::lower_bound(keys.begin(), keys.end(), probe));
+      CHECK(*exponentialLowerBound(squares.begin(), std::unreachable_sentinel,
+                                   int64_t(probe) * probe) ==
+            int64_t(probe) * probe);
+    }
+    std::vector<int> descending = {9, 7, 7, 4};
+    REQUIRE(exponentialLowerBound(descending.begin(), descending.end(), 7,
+                                  std::greater<>()) ==
+            descending.begin() + 1);
+  }
+
+  SECTION("Interpolation search handles even and skewed keys") {
+    for (size_t size : {0, 1, 2, 17, 18, 1000, 5000}) {
+      checkSearch(sortedKeys(size), [](const auto &keys, int probe) {
+        return interpolationSearch(keys, probe);
+      });
+    }
+
+    std::vector<int> skewed;
+    for (int i = 0; i < 1000; i++) {
+      skewed.push_back(i * i * i / 1000);
+    }
+    skewed.push_back(std::numeric_limits<int>::max());
+    checkSearch(skewed, [](const auto &keys, int probe) {
+      return interpolationSearch(keys, probe);
+    });
+
+    std::vector<uint64_t> wide = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+                                  13, 14, 15, 16, 17,
+                                  std::numeric_limits<uint64_t>::max() - 1,
+                                  std::numeric_limits<uint64_t>::max()};
+    for (size_t i = 0; i < wide.size(); i++) {
+      REQUIRE(interpolationSearch(wide, wide[i]) == std::optional<size_t>(i));
+    }
+
+    std::vector<double> infinite = {-INFINITY, -1.0, 0.0,      0.5,
+                                    1.0,       2.0,  3.0,      4.0,
+                                    5.0,       6.0,  7.0,      8.0,
+                                    9.0,       10.0, 11.0,     12.0,
+                                    13.0,      14.0, INFINITY};
+    for (size_t i = 0; i < infinite.size(); i++) {
+      REQUIRE(interpolationSearch(infinite, infinite[i]) ==
+              std::optional<size_t>(i));
+    }
+    REQUIRE_FALSE(interpolationSearch(infinite, 0.25).has_value());
+  }
+}
+
+TEST_CASE("Batch bound searching tests") {
+  auto expected = [](const std::vector<int> &keys,
+                     const std::vector<int> &queries) {
+    std::vector<size_t> positions;
+    for (int query : queries) {
+      positions.push_back(static_cast<size_t>(
+          std::lower_bound(keys.begin(), keys.end(), query) - keys.begin()));
+    }
+    return positions;
+  };
+
+  SECTION("Unsorted queries match the standard library") {
+    std::mt19937 generator(3);
+    for (size_t size : {0, 1, 2, 15, 16, 17, 1000}) {
+      std::vector<int> keys = sortedKeys(size);
+      for (size_t count : {0, 1, 15, 16, 17, 100}) {
+        std::vector<int> queries(count);
+        for (int &query : queries) {
+          query = static_cast<int>(generator() % (2 * size + 6)) - 2;
+        }
+        std::vector<size_t> positions;
+        batchLowerBound(keys, queries, std::back_inserter(positions));
+        CAPTURE(size, count);
+        CHECK(positions == expected(keys, queries));
+      }
+    }
+  }
+
+  SECTION("Sorted queries are answered by the merge-join") {
+    std::vector<int> keys = sortedKeys(1000);
+    std::vector<int> queries = {-5, -5, 0, 1, 2, 2, 3, 999, 1000, 1999, 5000};
+    std::vector<size_t> positions(queries.size());
+    auto end = batchLowerBound(keys, queries, positions.begin());
+    REQUIRE(end == positions.end());
+    REQUIRE(positions == expected(keys, queries));
+
+    std::vector<int> every(2004);
+    std::iota(every.begin(), every.end(), -2);
+    positions.clear();
+    batchLowerBound(keys, every, std::back_inserter(positions));
+    REQUIRE(positions == expected(keys, every));
+  }
+
+  SECTION("Batches take comparators, projections and views") {
+    std::vector<int> descending = {9, 7, 7, 7, 4, 1};
+    std::vector<size_t> positions;
+    batchLowerBound(descending, std::vector<int>{7, 10, 0, 4},
+                    std::back_inserter(positions), std::greater<>());
+    REQUIRE(positions == std::vector<size_t>{1, 0, 6, 4});
+
+    std::vector<std::pair<std::string, int>> records = {
+        {"ann", 19}, {"bob", 25}, {"cid", 25}, {"dan", 31}};
+    positions.clear();
+    batchLowerBound(records, std::views::iota(18, 33),
+                    std::back_inserter(positions), std::ranges::less(),
+                    &std::pair<std::string, int>::second);
+    REQUIRE(positions.size() == 15);
+    REQUIRE(positions[0] == 0);
+    REQUIRE(positions[7] == 1);
+    REQUIRE(positions[8] == 3);
+    REQUIRE(positions[14] == 4);
+  }
+}
+
+TEMPLATE_TEST_CASE("Static search index tests", "[StaticSearchIndex]",
+                   int32_t, uint32_t, int64_t, uint64_t, float, double,
+                   int16_t) {
+  auto makeKeys = [](size_t size) {
+    std::mt19937_64 generator(23);
+    std::vector<TestType> keys(size);
+    for (TestType &key : keys) {
+      // duplicates, and for the signed types negative keys
+      key = static_cast<TestType>(static_cast<int64_t>(generator() % 4000) -
+                                  (std::is_signed_v<TestType> ? 2000 : 0));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  };
+
+  SECTION("Both layouts agree with std::lower_bound") {
+    for (size_t size : {0, 1, 2, 3, 7, 16, 17, 289, 290, 1023, 1024, 5000}) {
+      std::vector<TestType> keys = makeKeys(size);
+      StaticSearchIndex<TestType> eytzinger(keys, IndexLayout::EYTZINGER);
+      StaticSearchIndex<TestType> sTree(keys, IndexLayout::S_TREE);
+      for (int64_t probe = -2002; probe < 4002; probe += 3) {
+        auto value = static_cast<TestType>(probe);
+        if (std::is_unsigned_v<TestType> && probe < 0) {
+          value = std::numeric_limits<TestType>::max() -
+                  static_cast<TestType>(-probe);
+        }
+        auto expected = static_cast<size_t>(
+            std::lower_bound(keys.begin(), keys.end(), value) - keys.begin());
+        CAPTURE(size, value);
+        CHECK(eytzinger.lowerBound(value) == expected);
+        CHECK(sTree.lowerBound(value) == expected);
+      }
+    }
+  }
+
+  SECTION("The extreme keys are found") {
+    std::vector<TestType> keys = {std::numeric_limits<TestType>::lowest(),
+                                  TestType(0), TestType(0),
+                                  std::numeric_limits<TestType>::max()};
+    for (IndexLayout layout : {IndexLayout::EYTZINGER, IndexLayout::S_TREE}) {
+      StaticSearchIndex<TestType> index(keys, layout);
+      REQUIRE(index.getSize() == 4);
+      REQUIRE(index.lowerBound(std::numeric_limits<TestType>::lowest()) == 0);
+      REQUIRE(index.lowerBound(TestType(0)) ==
+              (std::is_signed_v<TestType> ? 1 : 0));
+      REQUIRE(index.lowerBound(std::numeric_limits<TestType>::max()) == 3);
+    }
+  }
+}
+
+TEST_CASE("Static search index construction tests") {
+  SECTION("Indexes build from std::vector, Vector and spans") {
+    Vector<int64_t> vector = {2, 4, 4, 8};
+    StaticSearchIndex<int64_t> fromVector(vector);
+    REQUIRE(fromVector.lowerBound(4) == 1);
+    REQUIRE(fromVector.getLayout() == IndexLayout::S_TREE);
+    std::vector<int64_t> keys = {1, 5, 9};
+    StaticSearchIndex<int64_t> fromSpan(std::span<const int64_t>(keys),
+                                        IndexLayout::EYTZINGER);
+    REQUIRE(fromSpan.lowerBound(6) == 2);
+    REQUIRE(fromSpan.lowerBound(10) == 3);
+  }
+
+  SECTION("Unsorted keys are rejected") {
+    std::vector<int32_t> keys = {3, 1, 2};
+    REQUIRE_THROWS_AS(StaticSearchIndex<int32_t>(keys), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Learned index tests") {
+  auto checkEveryProbe = [](const std::vector<uint64_t> &keys,
+                              const LearnedIndex &index) {
+    std::mt19937_64 generator(11);
+    auto check = [&](uint64_t probe) {
+      CAPTURE(keys.size(), probe);
+      auto expected = static_cast<size_t>(
+          std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin());
+      CHECK(index.lowerBound(probe) == expected);
+    };
+    for (uint64_t key : keys) {
+      check(key);
+      check(key - 1);
+      check(key + 1);
+    }
+    for (int i = 0; i < 2000; i++) {
+      check(generator());
+      check(keys.empty() ? 0 : keys.front() + generator() % 100000);
+    }
+    check(0);
+    check(std::numeric_limits<uint64_t>::max());
+  };
+
+  SECTION("Lookups match the standard library on several distributions") {
+    std::mt19937_64 generator(5);
+    std::vector<uint64_t> uniform(20000);
+    for (uint64_t &key : uniform) {
+      key = generator();
+    }
+    std::vector<uint64_t> duplicates(20000);
+    for (uint64_t &key : duplicates) {
+      key = generator() % 300;
+    }
+    std::vector<uint64_t> clustered(20000);
+    for (uint64_t &key : clustered) {
+      key = (generator() % 8) * (uint64_t(1) << 40) + generator() % 5000;
+    }
+    std::vector<uint64_t> extremes = {0, 0, 1,
+                                      std::numeric_limits<uint64_t>::max()};
+    for (auto *keys : {&uniform, &duplicates, &clustered, &extremes}) {
+      std::sort(keys->begin(), keys->end());
+      for (size_t errorBound : {0, 4, 32, 256}) {
+        LearnedIndex index(*keys, errorBound);
+        CAPTURE(errorBound);
+        checkEveryProbe(*keys, index);
+        REQUIRE(index.getMaxError() <= errorBound + 1);
+      }
+    }
+  }
+
+  SECTION("Tiny inputs") {
+    for (size_t size : {0, 1, 2, 3}) {
+      std::vector<uint64_t> keys;
+      for (size_t i = 0; i < size; i++) {
+        keys.push_back(10 * i + 7);
+      }
+      LearnedIndex index(keys);
+      REQUIRE(index.getSize() == size);
+      checkEveryProbe(keys, index);
+    }
+  }
+
+  SECTION("Any radix width works on keys spanning the whole range") {
+    std::vector<uint64_t> keys = {0, 5, std::numeric_limits<uint64_t>::max()};
+    for (unsigned radixBits : {0, 1, 2, 30}) {
+      LearnedIndex index(keys, 32, radixBits);
+      CAPTURE(radixBits);
+      checkEveryProbe(keys, index);
+    }
+  }
+
+  SECTION("The model is far smaller than the keys") {
+    std::vector<uint64_t> keys(1 << 18);
+    std::mt19937_64 generator(9);
+    for (uint64_t &key : keys) {
+      key = generator() >> 8;
+    }
+    std::sort(keys.begin(), keys.end());
+    LearnedIndex index(keys, 64);
+    REQUIRE(index.getSegmentCount() > 0);
+    REQUIRE(index.getModelSize() * 20 < keys.size() * sizeof(uint64_t));
+    REQUIRE(index.find(keys[1234]) ==
+            std::optional<size_t>(static_cast<size_t>(
+                std::lower_bound(keys.begin(), keys.end(), keys[1234]) -
+                keys.begin())));
+    REQUIRE_FALSE(index.find(keys.back() + 1).has_value());
+  }
+
+  SECTION("Bad arguments are rejected") {
+    std::vector<uint64_t> unsorted = {3, 1, 2};
+    REQUIRE_THROWS_AS(LearnedIndex(unsorted), std::invalid_argument);
+    std::vector<uint64_t> keys = {1, 2, 3};
+    REQUIRE_THROWS_AS(LearnedIndex(keys, 8, 31), std::invalid_argument);
+  }
+
+  SECTION("Temporary keys are rejected at compile time") {
+    STATIC_REQUIRE_FALSE(
+        std::is_constructible_v<LearnedIndex, std::vector<uint64_t>>);
+    STATIC_REQUIRE_FALSE(
+        std::is_constructible_v<LearnedIndex, std::vector<uint64_t>, size_t>);
+    STATIC_REQUIRE(
+        std::is_constructible_v<LearnedIndex, std::vector<uint64_t> &>);
+    STATIC_REQUIRE(
+        std::is_constructible_v<LearnedIndex, const std::vector<uint64_t> &>);
+  }
+}
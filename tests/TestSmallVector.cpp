@@ -0,0 +1,200 @@
+#include <catch2/catch_test_macros.hpp>
+#define CATCH_CONFIG_MAIN
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "SmallVector.h"
+
+namespace {
+// counts live copies and throws on the copy that reaches the limit
+struct FailingCopy {
+  static inline int live = 0;
+  static inline int copiesLeft = 0;
+
+  FailingCopy() { live++; }
+  FailingCopy(const FailingCopy & /*other*/) {
+    if (copiesLeft-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+    live++;
+  }
+  FailingCopy &operator=(const FailingCopy &other) = default;
+  ~FailingCopy() { live--; }
+};
+}  // namespace
+
+TEST_CASE("SmallVector tests") {
+  SECTION("Default constructor keeps the elements inline") {
+    SmallVector<int, 8> vector;
+    REQUIRE(vector.getSize() == 0);
+    REQUIRE(vector.getCapacity() == 8);
+    REQUIRE(vector.isInline());
+    REQUIRE(vector.begin() == vector.end());
+  }
+
+  SECTION("Pushing back up to N elements does not leave inline storage") {
+    SmallVector<int, 8> vector;
+    for (int i = 0; i < 8; ++i) {
+      vector.pushBack(i);
+    }
+    REQUIRE(vector.isInline());
+    REQUIRE(vector.getCapacity() == 8);
+    for (int i = 0; i < 8; ++i) {
+      REQUIRE(vector[i] == i);
+    }
+  }
+
+  SECTION("Pushing back past N spills to the heap and keeps the elements") {
+    SmallVector<std::string, 4> vector;
+    for (int i = 0; i < 20; ++i) {
+      vector.pushBack(std::to_string(i));
+    }
+    REQUIRE_FALSE(vector.isInline());
+    REQUIRE(vector.getSize() == 20);
+    REQUIRE(vector.getCapacity() >= 20);
+    for (int i = 0; i < 20; ++i) {
+      REQUIRE(vector[i] == std::to_string(i));
+    }
+  }
+
+  SECTION("Pushing back an element of the vector itself survives spilling") {
+    SmallVector<std::string, 1> vector = {"first"};
+    vector.pushBack(vector[0]);
+    REQUIRE(vector[1] == "first");
+  }
+
+  SECTION("Initializer list larger than N starts on the heap") {
+    SmallVector<int, 2> vector = {1, 2, 3, 4};
+    REQUIRE_FALSE(vector.isInline());
+    REQUIRE(vector.getSize() == 4);
+    REQUIRE(vector[3] == 4);
+  }
+
+  SECTION("Erasing shifts the elements") {
+    SmallVector<int, 4> vector = {1, 2, 3};
+    REQUIRE(vector.erase(1) == 2);
+    REQUIRE(vector.getSize() == 2);
+    REQUIRE(vector[0] == 1);
+    REQUIRE(vector[1] == 3);
+    REQUIRE_THROWS_AS(vector.erase(2), std::out_of_range);
+    REQUIRE_THROWS_AS(vector[2], std::out_of_range);
+  }
+
+  SECTION("Copies are deep for both inline and heap storage") {
+    SmallVector<std::string, 2> small = {"a"};
+    SmallVector<std::string, 2> large = {"a", "b", "c"};
+    SmallVector<std::string, 2> smallCopy(small);
+    SmallVector<std::string, 2> largeCopy;
+    largeCopy = large;
+    smallCopy[0] = "changed";
+    largeCopy[0] = "changed";
+    REQUIRE(small[0] == "a");
+    REQUIRE(large[0] == "a");
+    REQUIRE(smallCopy.isInline());
+    REQUIRE(largeCopy.getSize() == 3);
+  }
+
+  SECTION("Moving inline storage moves the elements") {
+    SmallVector<std::string, 4> vector = {"a", "b"};
+    SmallVector<std::string, 4> moved(std::move(vector));
+    REQUIRE(moved.isInline());
+    REQUIRE(moved.getSize() == 2);
+    REQUIRE(moved[1] == "b");
+    REQUIRE(vector.getSize() == 0);
+    REQUIRE(vector.isInline());
+  }
+
+  SECTION("Moving heap storage steals the buffer") {
+    SmallVector<int, 2> vector = {1, 2, 3};
+    const int *buffer = vector.begin();
+    SmallVector<int, 2> moved;
+    moved = std::move(vector);
+    REQUIRE(moved.begin() == buffer);
+    REQUIRE(vector.getSize() == 0);
+    REQUIRE(vector.getCapacity() == 2);
+    vector.pushBack(7);
+    REQUIRE(vector[0] == 7);
+  }
+
+  SECTION("Range-based for loop visits the elements in order") {
+    const SmallVector<int, 4> vector = {1, 2, 3};
+    int expected = 1;
+    for (int num : vector) {
+      REQUIRE(num == expected++);
+    }
+  }
+
+  SECTION("Resizing sets the capacity and can return inline") {
+    SmallVector<std::string, 4> vector = {"a", "b", "c", "d", "e", "f"};
+    REQUIRE(vector.resize(10));
+    REQUIRE(vector.getCapacity() == 10);
+    REQUIRE(vector.getSize() == 6);
+    vector.resize(3);
+    REQUIRE(vector.isInline());
+    REQUIRE(vector.getCapacity() == 4);
+    REQUIRE(vector.getSize() == 3);
+    REQUIRE(vector[2] == "c");
+    vector.resize(1);
+    REQUIRE(vector.getSize() == 1);
+    REQUIRE(vector[0] == "a");
+  }
+
+  SECTION("Constructors that fail part way release what they built") {
+    FailingCopy prototype;
+    FailingCopy::copiesLeft = 5;
+    REQUIRE_THROWS_AS((SmallVector<FailingCopy, 2>(8, prototype)),
+                      std::runtime_error);
+    REQUIRE(FailingCopy::live == 1);
+
+    FailingCopy::copiesLeft = 100;
+    SmallVector<FailingCopy, 2> source(8, prototype);
+    FailingCopy::copiesLeft = 3;
+    REQUIRE_THROWS_AS((SmallVector<FailingCopy, 2>(source)),
+                      std::runtime_error);
+    REQUIRE(FailingCopy::live == 9);
+
+    FailingCopy::copiesLeft = 4;
+    REQUIRE_THROWS_AS(
+        (SmallVector<FailingCopy, 2>{prototype, prototype, prototype,
+                                     prototype, prototype, prototype}),
+        std::runtime_error);
+  }
+
+  SECTION("A copy that throws while growing leaves the vector unchanged") {
+    FailingCopy::live = 0;
+    {
+      SmallVector<FailingCopy, 2> vector;
+      vector.emplaceBack();
+      vector.emplaceBack();
+      // spilling the inline elements to the heap
+      FailingCopy::copiesLeft = 1;
+      REQUIRE_THROWS_AS(vector.emplaceBack(), std::runtime_error);
+      REQUIRE(vector.getSize() == 2);
+      REQUIRE(vector.getCapacity() == 2);
+      REQUIRE(FailingCopy::live == 2);
+
+      FailingCopy::copiesLeft = 100;
+      vector.emplaceBack();
+      vector.emplaceBack();
+      REQUIRE(vector.getCapacity() == 4);
+      // growing on the heap
+      FailingCopy::copiesLeft = 2;
+      REQUIRE_THROWS_AS(vector.emplaceBack(), std::runtime_error);
+      FailingCopy::copiesLeft = 3;
+      REQUIRE_THROWS_AS(vector.reserve(16), std::runtime_error);
+      REQUIRE(vector.getSize() == 4);
+      REQUIRE(vector.getCapacity() == 4);
+      REQUIRE(FailingCopy::live == 4);
+    }
+    REQUIRE(FailingCopy::live == 0);
+  }
+
+  SECTION("Output stream operator prints the elements") {
+    SmallVector<int, 4> vector = {1, 2, 3};
+    SmallVector<int, 4> empty;
+    std::ostringstream oss;
+    oss << vector << "|" << empty;
+    REQUIRE(oss.str() == "1 2 3|");
+  }
+}
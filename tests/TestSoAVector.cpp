@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#define CATCH_CONFIG_MAIN
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "SoAVector.h"
+#include "Sorting.h"
+#include "TimSort.h"
+
+namespace {
+// a field whose copy throws when asked to
+struct Fragile {
+  bool failOnCopy = false;
+
+  Fragile() = default;
+  explicit Fragile(bool failOnCopy) : failOnCopy(failOnCopy) {}
+  Fragile(const Fragile &other) : failOnCopy(other.failOnCopy) {
+    if (this->failOnCopy) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  Fragile &operator=(const Fragile &other) = default;
+};
+}  // namespace
+
+TEST_CASE("SoAVector tests") {
+  SECTION("Pushing back rows stores every field in its own column") {
+    SoAVector<int, double, std::string> records;
+    for (int i = 0; i < 100; i++) {
+      records.pushBack(i, i * 0.5, std::to_string(i));
+    }
+    REQUIRE(records.getSize() == 100);
+    REQUIRE(records.column<0>().size() == 100);
+    REQUIRE(records.column<1>()[10] == 5.0);
+    REQUIRE(records.column<2>()[99] == "99");
+    // columns are contiguous arrays of a single field
+    REQUIRE(&records.column<0>()[1] == &records.column<0>()[0] + 1);
+  }
+
+  SECTION("Rows are references into the columns") {
+    SoAVector<int, std::string> records = {{1, "one"}, {2, "two"}};
+    auto [id, name] = records[1];
+    id = 20;
+    name = "twenty";
+    REQUIRE(records.column<0>()[1] == 20);
+    REQUIRE(std::get<1>(records[1]) == "twenty");
+    REQUIRE_THROWS_AS(records[2], std::out_of_range);
+  }
+
+  SECTION("Row loops visit the rows in order") {
+    SoAVector<int, int> records = {{1, 10}, {2, 20}, {3, 30}};
+    for (auto [key, value] : records) {
+      value += key;
+    }
+    int expected = 1;
+    const SoAVector<int, int> &view = records;
+    for (auto [key, value] : view) {
+      REQUIRE(key == expected);
+      REQUIRE(value == 11 * expected);
+      expected++;
+    }
+    REQUIRE(expected == 4);
+  }
+
+  SECTION("Column scans run over a single field") {
+    SoAVector<int, double> records;
+    for (int i = 1; i <= 10; i++) {
+      records.pushBack(i, 1.0);
+    }
+    std::span<const int> keys = std::as_const(records).column<0>();
+    REQUIRE(std::accumulate(keys.begin(), keys.end(), 0) == 55);
+  }
+
+  SECTION("Sorting a column in place leaves the other columns alone") {
+    SoAVector<int, char> records = {{3, 'a'}, {1, 'b'}, {2, 'c'}};
+    introSort(records.column<0>());
+    std::span<const int> keys = std::as_const(records).column<0>();
+    REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+    REQUIRE(records.column<1>()[0] == 'a');
+    timSort(records.column<1>(), std::ranges::greater());
+    REQUIRE(records[0] == std::tuple<int, char>(1, 'c'));
+    REQUIRE(records[2] == std::tuple<int, char>(3, 'a'));
+  }
+
+  SECTION("Sorting by a column reorders whole rows stably") {
+    SoAVector<int, std::string> records = {
+        {3, "c"}, {1, "a"}, {2, "b"}, {1, "a2"}};
+    records.sortBy<0>();
+    REQUIRE(records[0] == std::tuple<int, std::string>(1, "a"));
+    REQUIRE(records[1] == std::tuple<int, std::string>(1, "a2"));
+    REQUIRE(records[3] == std::tuple<int, std::string>(3, "c"));
+    records.sortBy<1>(std::greater<>());
+    REQUIRE(std::get<1>(records[0]) == "c");
+    REQUIRE(records.getSize() == 4);
+  }
+
+  SECTION("Erasing returns the row and keeps the columns aligned") {
+    SoAVector<int, std::string> records = {{1, "one"}, {2, "two"}, {3, "x"}};
+    REQUIRE(records.erase(1) == std::tuple<int, std::string>(2, "two"));
+    REQUIRE(records.getSize() == 2);
+    REQUIRE(records[1] == std::tuple<int, std::string>(3, "x"));
+    REQUIRE(records.column<1>().size() == 2);
+    REQUIRE_THROWS_AS(records.erase(2), std::out_of_range);
+  }
+
+  SECTION("Pushing back one of its own rows survives growth") {
+    SoAVector<int, std::string> records;
+    records.pushBack(1, "first row, long enough to live on the heap");
+    // the columns start out with DEFAULT_CAPACITY slots
+    for (int i = 1; i < DEFAULT_CAPACITY; i++) {
+      records.pushBack(i + 1, "filler");
+    }
+    records.pushBack(std::get<0>(records[0]), std::get<1>(records[0]));
+    REQUIRE(records.getSize() == DEFAULT_CAPACITY + 1);
+    REQUIRE(records[DEFAULT_CAPACITY] == records[0]);
+    REQUIRE(std::get<1>(records[DEFAULT_CAPACITY]) ==
+            "first row, long enough to live on the heap");
+  }
+
+  SECTION("A failed pushBack leaves every column as it was") {
+    SoAVector<std::string, int, Fragile> records;
+    records.pushBack("kept", 1, Fragile());
+    for (size_t i = 0; i < 3; i++) {
+      REQUIRE_THROWS_AS(records.pushBack("lost", 2, Fragile(true)),
+                        std::runtime_error);
+    }
+    REQUIRE(records.getSize() == 1);
+    REQUIRE(records.column<0>().size() == 1);
+    records.pushBack("next", 3, Fragile());
+    REQUIRE(std::get<0>(records[1]) == "next");
+    REQUIRE(std::get<1>(records[1]) == 3);
+  }
+}
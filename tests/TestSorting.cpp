@@ -0,0 +1,884 @@
+#include <catch2/catch_test_macros.hpp>
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_template_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ExternalSort.h"
+#include "RadixSort.h"
+#include "SoAVector.h"
+#include "Sorting.h"
+#include "TimSort.h"
+#include "Vector.h"
+
+namespace {
+std::vector<std::vector<int>> patterns(size_t size) {
+  std::mt19937 generator(42);
+  std::vector<int> random(size);
+  std::vector<int> fewUnique(size);
+  std::vector<int> sorted(size);
+  std::vector<int> organPipe(size);
+  for (size_t i = 0; i < size; i++) {
+    random[i] = static_cast<int>(generator());
+    fewUnique[i] = static_cast<int>(generator() % 4);
+    sorted[i] = static_cast<int>(i);
+    organPipe[i] = static_cast<int>(std::min(i, size - i));
+  }
+  std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+  return {random, fewUnique, sorted, reversed, organPipe,
+          std::vector<int>(size, 7)};
+}
+
+template <typename Range>
+concept CanMergeSort = requires(Range &range) { mergeSort(range); };
+}  // namespace
+
+TEST_CASE("Sorting tests") {
+  SECTION("Introsort sorts every input pattern") {
+    for (size_t size : {0, 1, 2, 3, 16, 17, 100, 1000, 50000}) {
+      for (std::vector<int> input : patterns(size)) {
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        introSort(input.begin(), input.end());
+        REQUIRE(input == expected);
+      }
+    }
+  }
+
+  SECTION("Introsort takes a comparator") {
+    std::vector<std::string> words = {"pear", "fig", "apple", "kiwi", "date"};
+    introSort(words.begin(), words.end(), std::greater<>());
+    REQUIRE(words == std::vector<std::string>{"pear", "kiwi", "fig", "date",
+                                              "apple"});
+  }
+
+  SECTION("Introsort works on raw pointers and Vector") {
+    Vector<double> vector = {3.5, -1.0, 2.25, 0.0};
+    introSort(vector.begin(), vector.end());
+    REQUIRE(std::is_sorted(vector.begin(), vector.end()));
+    int array[] = {5, 4, 3, 2, 1};
+    introSort(std::begin(array), std::end(array));
+    REQUIRE(std::is_sorted(std::begin(array), std::end(array)));
+  }
+
+  SECTION("Heapsort and iterator insertion sort sort every input pattern") {
+    for (std::vector<int> input : patterns(300)) {
+      std::vector<int> copy = input;
+      heapSort(input.begin(), input.end());
+      insertionSort(copy.begin(), copy.end());
+      REQUIRE(std::is_sorted(input.begin(), input.end()));
+      REQUIRE(input == copy);
+    }
+  }
+}
+
+TEST_CASE("Generic sorting interface tests") {
+  struct Record {
+    std::string name;
+    int age;
+  };
+  using Sorter = std::function<void(std::vector<int>::iterator,
+                                    std::vector<int>::iterator)>;
+  const std::vector<std::pair<std::string, Sorter>> sorters = {
+      {"bubbleSort", [](auto first, auto last) { bubbleSort(first, last); }},
+      {"selectionSort",
+       [](auto first, auto last) { selectionSort(first, last); }},
+      {"insertionSort",
+       [](auto first, auto last) { insertionSort(first, last); }},
+      {"mergeSort", [](auto first, auto last) { mergeSort(first, last); }},
+      {"quickSort", [](auto first, auto last) { quickSort(first, last); }},
+      {"heapSort", [](auto first, auto last) { heapSort(first, last); }},
+      {"countingSort",
+       [](auto first, auto last) { countingSort(first, last); }},
+  };
+
+  SECTION("Every algorithm sorts every input pattern through iterators") {
+    for (const auto &[name, sorter] : sorters) {
+      for (std::vector<int> input : patterns(300)) {
+        if (name == "countingSort") {
+          // keep the key range small, negative keys included
+          for (int &value : input) {
+            value %= 1000;
+          }
+        }
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        sorter(input.begin(), input.end());
+        INFO(name);
+        REQUIRE(input == expected);
+      }
+    }
+  }
+
+  SECTION("Comparators sort descending") {
+    std::vector<int> input = {3, 1, 4, 1, 5, 9, 2, 6};
+    std::vector<int> expected = {9, 6, 5, 4, 3, 2, 1, 1};
+    std::vector<int> copy = input;
+    bubbleSort(copy.begin(), copy.end(), std::greater<>());
+    REQUIRE(copy == expected);
+    copy = input;
+    selectionSort(copy.begin(), copy.end(), std::greater<>());
+    REQUIRE(copy == expected);
+    copy = input;
+    mergeSort(copy.begin(), copy.end(), std::greater<>());
+    REQUIRE(copy == expected);
+    copy = input;
+    quickSort(copy.begin(), copy.end(), std::greater<>());
+    REQUIRE(copy == expected);
+  }
+
+  SECTION("Projections sort records by a member") {
+    std::vector<Record> people = {
+        {"Ann", 31}, {"Bob", 25}, {"Cid", 31}, {"Dan", 19}};
+    mergeSort(people, std::ranges::less(), &Record::age);
+    REQUIRE(people[0].name == "Dan");
+    REQUIRE(people[2].name == "Ann");
+    REQUIRE(people[3].name == "Cid");
+    insertionSort(people, std::ranges::greater(), &Record::name);
+    REQUIRE(people[0].name == "Dan");
+    countingSort(people, &Record::age);
+    REQUIRE(people[0].age == 19);
+    REQUIRE(people[3].age == 31);
+  }
+
+  SECTION("Merge sort rejects elements it cannot copy into its scratch") {
+    STATIC_REQUIRE(CanMergeSort<std::vector<std::string>>);
+    STATIC_REQUIRE_FALSE(CanMergeSort<std::vector<std::unique_ptr<int>>>);
+  }
+
+  SECTION("Ranges cover Vector, spans, subranges and plain arrays") {
+    Vector<int> vector = {5, 3, 8, 1};
+    quickSort(vector);
+    REQUIRE(std::is_sorted(vector.begin(), vector.end()));
+
+    std::vector<int> partial = {9, 8, 7, 6, 5, 4};
+    selectionSort(std::span<int>(partial).subspan(1, 4));
+    REQUIRE(partial == std::vector<int>{9, 5, 6, 7, 8, 4});
+
+    int array[] = {2, 7, 1};
+    heapSort(array, std::ranges::greater());
+    REQUIRE(array[0] == 7);
+    REQUIRE(array[2] == 1);
+  }
+
+  SECTION("Sorting routines run on a single SoAVector column") {
+    SoAVector<int, double> records = {{4, 0.5}, {2, 1.5}, {3, 2.5}};
+    introSort(records.column<0>());
+    REQUIRE(records.column<0>()[0] == 2);
+    REQUIRE(records.column<1>()[0] == 0.5);
+  }
+
+  SECTION("The std::vector overloads still work") {
+    std::vector<int> input = {4, -2, 7, 0};
+    std::vector<int> copy = input;
+    insertionSort(copy);
+    REQUIRE(copy == std::vector<int>{-2, 0, 4, 7});
+    copy = input;
+    countingSort(copy);
+    REQUIRE(copy == std::vector<int>{-2, 0, 4, 7});
+    copy = input;
+    bubbleSort(copy);
+    REQUIRE(copy == std::vector<int>{-2, 0, 4, 7});
+  }
+
+  SECTION("Counting sort handles keys spanning the whole type") {
+    std::vector<int64_t> extremes = {INT64_MAX, 0, INT64_MIN, -1, INT64_MAX};
+    countingSort(extremes);
+    REQUIRE(extremes ==
+            std::vector<int64_t>{INT64_MIN, -1, 0, INT64_MAX, INT64_MAX});
+
+    std::vector<Record> people = {
+        {"Ann", INT32_MAX}, {"Bob", INT32_MIN}, {"Cid", INT32_MAX}, {"Dan", 0}};
+    countingSort(people, &Record::age);
+    REQUIRE(people[0].name == "Bob");
+    REQUIRE(people[1].name == "Dan");
+    REQUIRE(people[2].name == "Ann");
+    REQUIRE(people[3].name == "Cid");
+  }
+
+  SECTION("Counting sort handles negative narrow keys") {
+    std::vector<int16_t> shorts = {3, -5, 1, -2, 0, INT16_MIN, INT16_MAX};
+    countingSort(shorts);
+    REQUIRE(shorts ==
+            std::vector<int16_t>{INT16_MIN, -5, -2, 0, 1, 3, INT16_MAX});
+
+    std::vector<signed char> chars = {3, -128, 1, -2, 127, 0};
+    countingSort(chars);
+    REQUIRE(chars == std::vector<signed char>{-128, -2, 0, 1, 3, 127});
+  }
+}
+
+TEST_CASE("Partition strategy tests") {
+  const PartitionStrategy strategies[] = {
+      PartitionStrategy::HOARE, PartitionStrategy::LOMUTO,
+      PartitionStrategy::BLOCK};
+
+  SECTION("Every strategy sorts every input pattern") {
+    for (PartitionStrategy strategy : strategies) {
+      for (size_t size : {0, 1, 2, 17, 129, 1000, 30000}) {
+        for (std::vector<int> input : patterns(size)) {
+          std::vector<int> expected = input;
+          std::sort(expected.begin(), expected.end());
+          quickSort(input.begin(), input.end(), strategy);
+          REQUIRE(input == expected);
+        }
+      }
+    }
+  }
+
+  SECTION("Block partition handles comparators, projections and ranges") {
+    std::vector<std::pair<int, int>> records;
+    for (int i = 0; i < 5000; i++) {
+      records.push_back({(i * 7919) % 37, i});
+    }
+    quickSort(records, PartitionStrategy::BLOCK, std::greater<>(),
+              &std::pair<int, int>::first);
+    REQUIRE(std::is_sorted(records.begin(), records.end(),
+                           [](const auto &left, const auto &right) {
+                             return left.first > right.first;
+                           }));
+  }
+
+  SECTION("Block partition reports partitioned input and splits duplicates") {
+    std::vector<int> sorted(1000);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::less<> less;
+    std::iter_swap(sorted.begin(), sorted.begin() + 500);
+    auto [cut, alreadyPartitioned] =
+        blockPartition(sorted.begin(), sorted.end(), less);
+    REQUIRE(alreadyPartitioned);
+    REQUIRE(*cut == 500);
+
+    std::vector<int> duplicates = {3, 5, 3, 3, 4, 3, 5};
+    auto middle = partitionEqual(duplicates.begin(), duplicates.end(), less);
+    REQUIRE(middle - duplicates.begin() == 3);
+    REQUIRE(std::count(duplicates.begin(), middle + 1, 3) == 4);
+  }
+}
+
+TEMPLATE_TEST_CASE("Sorting network tests", "[Network]", int32_t, int64_t,
+                   float, double) {
+  std::mt19937_64 generator(11);
+  auto randomBlock = [&generator](size_t size, int64_t range) {
+    std::vector<TestType> values(size);
+    for (TestType &value : values) {
+      value = static_cast<TestType>(static_cast<int64_t>(generator() % range) -
+                                    range / 2);
+    }
+    return values;
+  };
+
+#ifdef SORTING_NETWORKS_X86
+  SECTION("Networks sort every block size up to the maximum") {
+    // without AVX2 the sorts fall back to insertion sort
+    for (size_t size = 0; hasSortingNetworks() && size <= NETWORK_SORT_MAX;
+         size++) {
+      for (int64_t range : {3, 1000}) {
+        std::vector<TestType> input = randomBlock(size, range);
+        std::vector<TestType> expected = input;
+        std::sort(expected.begin(), expected.end());
+        networkSortAvx2(input.data(), input.size());
+        CAPTURE(size, range);
+        CHECK(input == expected);
+      }
+    }
+  }
+
+  SECTION("The vectorized merge matches std::merge") {
+    for (size_t leftSize = 0; hasSortingNetworks() && leftSize < 40;
+         leftSize++) {
+      for (size_t rightSize : {0, 1, 3, 8, 9, 31, 100}) {
+        std::vector<TestType> left = randomBlock(leftSize, 50);
+        std::vector<TestType> right = randomBlock(rightSize, 50);
+        std::sort(left.begin(), left.end());
+        std::sort(right.begin(), right.end());
+        std::vector<TestType> merged(leftSize + rightSize);
+        std::vector<TestType> expected(leftSize + rightSize);
+        std::merge(left.begin(), left.end(), right.begin(), right.end(),
+                   expected.begin());
+        networkMergeAvx2(left.data(), leftSize, right.data(), rightSize,
+                         merged.data());
+        CAPTURE(leftSize, rightSize);
+        CHECK(merged == expected);
+      }
+    }
+  }
+#endif
+
+  SECTION("Quicksort and merge sort use the networks as their base case") {
+    for (size_t size : {5, 64, 65, 300, 20000}) {
+      std::vector<TestType> input = randomBlock(size, 1 << 20);
+      std::vector<TestType> expected = input;
+      std::sort(expected.begin(), expected.end());
+      for (PartitionStrategy strategy :
+           {PartitionStrategy::HOARE, PartitionStrategy::BLOCK}) {
+        std::vector<TestType> copy = input;
+        quickSort(copy.begin(), copy.end(), strategy);
+        REQUIRE(copy == expected);
+      }
+      std::vector<TestType> copy = input;
+      mergeSort(copy);
+      REQUIRE(copy == expected);
+      copy = input;
+      parallelMergeSort(copy.begin(), copy.end(), std::less<>(), 2);
+      REQUIRE(copy == expected);
+    }
+  }
+
+  SECTION("Equal values are exchanged, never duplicated") {
+    if constexpr (std::is_floating_point_v<TestType>) {
+      std::vector<TestType> zeros;
+      for (int i = 0; i < 100; i++) {
+        zeros.push_back(i % 3 == 0 ? TestType(-0.0) : TestType(0.0));
+      }
+      quickSort(zeros);
+      REQUIRE(std::count_if(zeros.begin(), zeros.end(), [](TestType value) {
+                return std::signbit(value);
+              }) == 34);
+    }
+  }
+
+  SECTION("Merge sorts keep signed zeros in their input order") {
+    if constexpr (std::is_floating_point_v<TestType>) {
+      std::mt19937 generator(21);
+      for (size_t size : {100, 1000, 20000}) {
+        std::vector<TestType> input;
+        for (size_t i = 0; i < size; i++) {
+          TestType zero = generator() % 2 == 0 ? TestType(-0.0) : TestType(0.0);
+          input.push_back(generator() % 4 == 0 ? TestType(1) : zero);
+        }
+        std::vector<TestType> expected = input;
+        std::stable_sort(expected.begin(), expected.end());
+        auto sameSigns = [&expected](const std::vector<TestType> &sorted) {
+          return std::equal(sorted.begin(), sorted.end(), expected.begin(),
+                            [](TestType left, TestType right) {
+                              return std::signbit(left) == std::signbit(right);
+                            });
+        };
+        std::vector<TestType> copy = input;
+        mergeSort(copy);
+        REQUIRE(sameSigns(copy));
+        copy = input;
+        parallelMergeSort(copy.begin(), copy.end(), std::less<>(), 2);
+        REQUIRE(sameSigns(copy));
+      }
+    }
+  }
+}
+
+TEST_CASE("Adaptive stable sorting tests") {
+  SECTION("TimSort sorts every input pattern") {
+    for (size_t size : {0, 1, 2, 31, 32, 65, 1000, 50000}) {
+      for (std::vector<int> input : patterns(size)) {
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        timSort(input.begin(), input.end());
+        REQUIRE(input == expected);
+      }
+    }
+  }
+
+  SECTION("TimSort is stable across runs, galloping and both merge sides") {
+    std::mt19937 generator(5);
+    for (int shape = 0; shape < 4; shape++) {
+      std::vector<std::pair<int, int>> records(20000);
+      for (size_t i = 0; i < records.size(); i++) {
+        int key = shape == 0   ? static_cast<int>(generator() % 8)
+                  : shape == 1 ? static_cast<int>(i % 3000)
+                  : shape == 2 ? static_cast<int>(records.size() - i) / 5
+                               : static_cast<int>(i / 1000 + i % 7);
+        records[i] = {key, static_cast<int>(i)};
+      }
+      timSort(records, std::ranges::less(), &std::pair<int, int>::first);
+      CAPTURE(shape);
+      CHECK(std::is_sorted(records.begin(), records.end()));
+    }
+  }
+
+  SECTION("Presorted input takes a linear number of comparisons") {
+    const size_t size = 100000;
+    std::vector<int> sorted(size);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    size_t comparisons = 0;
+    auto counting = [&comparisons](int left, int right) {
+      comparisons++;
+      return left < right;
+    };
+    timSort(sorted, counting);
+    REQUIRE(comparisons == size - 1);
+
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    comparisons = 0;
+    timSort(reversed, counting);
+    REQUIRE(reversed == sorted);
+    REQUIRE(comparisons == size - 1);
+
+    // a sorted array with a sorted batch appended is one galloping merge
+    std::vector<int> batches(sorted.begin(), sorted.end());
+    for (int i = 0; i < 1000; i++) {
+      batches.push_back(i * 100 + 50);
+    }
+    comparisons = 0;
+    timSort(batches, counting);
+    REQUIRE(std::is_sorted(batches.begin(), batches.end()));
+    REQUIRE(comparisons < 2 * batches.size());
+  }
+
+  SECTION("TimSort moves elements that cannot be copied") {
+    std::vector<std::unique_ptr<int>> pointers;
+    for (int i = 0; i < 500; i++) {
+      pointers.push_back(std::make_unique<int>((i * 7919) % 500));
+    }
+    timSort(pointers, std::ranges::less(),
+            [](const std::unique_ptr<int> &pointer) { return *pointer; });
+    REQUIRE(std::is_sorted(pointers.begin(), pointers.end(),
+                           [](const auto &left, const auto &right) {
+                             return *left < *right;
+                           }));
+  }
+}
+
+TEST_CASE("Selection tests") {
+  SECTION("nthElement places every rank of every input pattern") {
+    for (size_t size : {1, 2, 5, 130, 1000}) {
+      std::vector<std::vector<int>> inputs = patterns(size);
+      for (size_t pattern = 0; pattern < inputs.size(); pattern++) {
+        const std::vector<int> &input = inputs[pattern];
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        for (size_t rank = 0; rank < size; rank += 1 + size / 40) {
+          std::vector<int> copy = input;
+          auto nth = copy.begin() + static_cast<std::ptrdiff_t>(rank);
+          nthElement(copy.begin(), nth, copy.end());
+          CAPTURE(size, pattern, rank);
+          CHECK(*nth == expected[rank]);
+          CHECK(std::all_of(copy.begin(), nth,
+                            [nth](int value) { return value <= *nth; }));
+          CHECK(std::all_of(nth, copy.end(),
+                            [nth](int value) { return value >= *nth; }));
+        }
+      }
+    }
+  }
+
+  SECTION("The median-of-medians fallback selects correctly on its own") {
+    std::vector<int> input = patterns(5000)[0];
+    std::vector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+    std::less<> less;
+    auto nth = input.begin() + 1234;
+    introSelectLoop(input.begin(), nth, input.end(), 0, less);
+    REQUIRE(*nth == expected[1234]);
+
+    // at least 3/10 of the elements lie on either side of the pivot
+    std::vector<int> copy = patterns(5000)[0];
+    int pivot = *medianOfMedians(copy.begin(), copy.end(), less);
+    auto rank = std::lower_bound(expected.begin(), expected.end(), pivot) -
+                expected.begin();
+    REQUIRE(rank >= 1400);
+    REQUIRE(rank <= 3600);
+  }
+
+  SECTION("partialSort sorts the prefix and keeps the other elements") {
+    for (size_t prefix : {0, 1, 10, 100, 999, 1000}) {
+      for (std::vector<int> input : patterns(1000)) {
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        auto middle = input.begin() + static_cast<std::ptrdiff_t>(prefix);
+        partialSort(input.begin(), middle, input.end());
+        REQUIRE(std::equal(input.begin(), middle, expected.begin()));
+        std::sort(middle, input.end());
+        REQUIRE(input == expected);
+      }
+    }
+  }
+
+  SECTION("Selection takes comparators, projections and ranges") {
+    std::vector<std::pair<int, int>> records;
+    for (int i = 0; i < 300; i++) {
+      records.push_back({(i * 7919) % 300, i});
+    }
+    partialSort(records, records.begin() + 3, std::greater<>(),
+                &std::pair<int, int>::first);
+    REQUIRE(records[0].first == 299);
+    REQUIRE(records[2].first == 297);
+    nthElement(records, records.begin() + 150, std::ranges::less(),
+               &std::pair<int, int>::first);
+    REQUIRE(records[150].first == 150);
+  }
+
+  SECTION("topK keeps the best k of a single pass") {
+    std::vector<int> input = patterns(100000)[0];
+    std::vector<int> expected = input;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    expected.resize(100);
+    REQUIRE(topK(input, 100, std::greater<>()) == expected);
+    REQUIRE(topK(input, 0).empty());
+    REQUIRE(topK(std::vector<int>{3, 1, 2}, 10) == std::vector<int>{1, 2, 3});
+
+    std::istringstream stream("5 3 9 1 7");
+    REQUIRE(topK(std::views::istream<int>(stream), 2) ==
+            std::vector<int>{1, 3});
+
+    std::vector<std::string> words = {"kiwi", "fig", "banana", "apple"};
+    REQUIRE(topK(words, 2, std::ranges::less(), &std::string::size) ==
+            std::vector<std::string>{"fig", "kiwi"});
+  }
+}
+
+TEST_CASE("Parallel sorting tests") {
+  SECTION("Parallel merge sort sorts every input pattern") {
+    for (size_t threads : {1, 2, 4}) {
+      for (size_t size : {0, 1, 17, 1000, 100000}) {
+        for (std::vector<int> input : patterns(size)) {
+          std::vector<int> expected = input;
+          std::sort(expected.begin(), expected.end());
+          parallelMergeSort(input.begin(), input.end(), std::less<>(),
+                            threads);
+          REQUIRE(input == expected);
+        }
+      }
+    }
+  }
+
+  SECTION("Parallel merge sort is stable") {
+    std::mt19937 generator(7);
+    std::vector<std::pair<int, int>> records(60000);
+    for (size_t i = 0; i < records.size(); i++) {
+      records[i] = {static_cast<int>(generator() % 100), static_cast<int>(i)};
+    }
+    parallelMergeSort(
+        records.begin(), records.end(),
+        [](const auto &left, const auto &right) {
+          return left.first < right.first;
+        },
+        4);
+    REQUIRE(std::is_sorted(records.begin(), records.end()));
+  }
+
+  SECTION("Exceptions thrown by tasks reach the waiting thread") {
+    ThreadPool pool(2);
+    TaskGroup group(pool);
+    group.run([] { throw std::runtime_error("task failed"); });
+    group.run([] {});
+    REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+  }
+
+  SECTION("Threads waiting on a group keep stealing nested tasks") {
+    // the worker takes the outer task and spawns the inner ones only once
+    // this thread already waits; each inner task finishes only when two
+    // threads run inner tasks at the same time, so this thread has to steal
+    ThreadPool pool(1);
+    std::atomic<bool> started = false;
+    std::atomic<size_t> running = 0;
+    std::atomic<bool> timedOut = false;
+    TaskGroup outer(pool);
+    outer.run([&pool, &started, &running, &timedOut] {
+      started = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      TaskGroup inner(pool);
+      for (int i = 0; i < 2; i++) {
+        inner.run([&running, &timedOut] {
+          running++;
+          auto deadline =
+              std::chrono::steady_clock::now() + std::chrono::seconds(10);
+          while (running < 2) {
+            if (std::chrono::steady_clock::now() > deadline) {
+              timedOut = true;
+              return;
+            }
+            std::this_thread::yield();
+          }
+        });
+      }
+      inner.wait();
+    });
+    while (!started) {
+      std::this_thread::yield();
+    }
+    outer.wait();
+    REQUIRE_FALSE(timedOut);
+  }
+
+  SECTION("Parallel sample sort sorts every input pattern") {
+    for (size_t threads : {1, 2, 4}) {
+      for (size_t size : {0, 1, 1000, 200000}) {
+        for (std::vector<int> input : patterns(size)) {
+          std::vector<int> expected = input;
+          std::sort(expected.begin(), expected.end());
+          parallelSampleSort(input.begin(), input.end(), std::less<>(),
+                             threads);
+          REQUIRE(input == expected);
+        }
+      }
+    }
+    std::vector<std::string> words(100000);
+    for (size_t i = 0; i < words.size(); i++) {
+      words[i] = std::to_string((i * 7919) % words.size());
+    }
+    parallelSampleSort(words.begin(), words.end(), std::greater<>(), 3);
+    REQUIRE(std::is_sorted(words.begin(), words.end(), std::greater<>()));
+  }
+
+  SECTION("The splitter tree assigns every element its bucket") {
+    std::vector<int> splitters = {10, 20, 20, 30, 40, 50, 60};
+    std::vector<int> tree = buildSplitterTree(splitters);
+    std::vector<int> values = {-5, 10, 15, 20, 25, 35, 45, 59, 60, 99, 20};
+    std::vector<uint8_t> buckets(values.size());
+    std::less<> less;
+    classifyBuckets(values.begin(), values.size(), tree, buckets.data(), less);
+    REQUIRE(buckets ==
+            std::vector<uint8_t>{0, 1, 1, 3, 3, 4, 5, 6, 7, 7, 3});
+  }
+
+  SECTION("The key-value sample sort moves values with their keys") {
+    for (size_t threads : {1, 4}) {
+      std::mt19937 generator(9);
+      std::vector<int64_t> keys(150000);
+      std::vector<std::string> values(keys.size());
+      for (size_t i = 0; i < keys.size(); i++) {
+        keys[i] = static_cast<int64_t>(generator() % 5000);
+        values[i] = std::to_string(keys[i]);
+      }
+      parallelSampleSortByKey(keys.begin(), keys.end(), values.begin(),
+                              std::less<>(), threads);
+      REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+      for (size_t i = 0; i < keys.size(); i++) {
+        CAPTURE(threads, i);
+        CHECK(values[i] == std::to_string(keys[i]));
+      }
+    }
+  }
+
+  SECTION("The key-value sample sort moves values that cannot be copied") {
+    std::vector<uint32_t> keys(100000);
+    std::vector<std::unique_ptr<uint32_t>> values(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      keys[i] = static_cast<uint32_t>((i * 7919) % 1000);
+      values[i] = std::make_unique<uint32_t>(keys[i]);
+    }
+    parallelSampleSortByKey(keys.begin(), keys.end(), values.begin(),
+                            std::greater<>(), 4);
+    REQUIRE(std::is_sorted(keys.begin(), keys.end(), std::greater<>()));
+    for (size_t i = 0; i < keys.size(); i++) {
+      CAPTURE(i);
+      REQUIRE(values[i] != nullptr);
+      CHECK(*values[i] == keys[i]);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Radix sorting tests", "[Radix]", int32_t, uint32_t,
+                   int64_t, uint64_t, int16_t, float, double) {
+  using Limits = std::numeric_limits<TestType>;
+  std::mt19937_64 generator(11);
+  std::vector<TestType> values = {Limits::max(), Limits::lowest(), 0, 1};
+  for (int i = 0; i < 20000; i++) {
+    if constexpr (std::is_floating_point_v<TestType>) {
+      values.push_back(static_cast<TestType>(
+          std::uniform_real_distribution<double>(-1e6, 1e6)(generator)));
+    } else {
+      values.push_back(static_cast<TestType>(generator()));
+    }
+  }
+
+  SECTION("LSD radix sort orders keys like std::sort") {
+    std::vector<TestType> expected = values;
+    std::sort(expected.begin(), expected.end());
+    radixSort(values.begin(), values.end());
+    REQUIRE(values == expected);
+  }
+
+  SECTION("Sorting by an extracted key is stable") {
+    std::vector<std::pair<TestType, size_t>> records;
+    for (size_t i = 0; i < values.size(); i++) {
+      records.push_back({values[i % 100], i});
+    }
+    radixSort(records.begin(), records.end(),
+              [](const auto &record) { return record.first; });
+    REQUIRE(std::is_sorted(records.begin(), records.end()));
+  }
+
+  SECTION("Records without a default constructor are sorted by key") {
+    struct Labelled {
+      TestType key;
+      std::string label;
+      Labelled(TestType key, std::string label)
+          : key(key), label(std::move(label)) {}
+    };
+    std::vector<Labelled> records;
+    for (size_t i = 0; i < 1000; i++) {
+      records.emplace_back(values[i], std::to_string(i));
+    }
+    radixSort(records.begin(), records.end(),
+              [](const Labelled &record) { return record.key; });
+    REQUIRE(std::is_sorted(records.begin(), records.end(),
+                           [](const Labelled &left, const Labelled &right) {
+                             return left.key < right.key;
+                           }));
+    REQUIRE(records[0].label == "1");
+  }
+
+  SECTION("A member pointer extracts the key") {
+    std::vector<std::pair<TestType, size_t>> records;
+    for (size_t i = 0; i < values.size(); i++) {
+      records.push_back({values[i], i});
+    }
+    radixSort(records.begin(), records.end(),
+              &std::pair<TestType, size_t>::first);
+    REQUIRE(std::is_sorted(records.begin(), records.end(),
+                           [](const auto &left, const auto &right) {
+                             return left.first < right.first;
+                           }));
+  }
+}
+
+TEST_CASE("String radix sorting tests") {
+  SECTION("American flag sort orders strings like std::sort") {
+    std::mt19937 generator(5);
+    std::vector<std::string> words = {"", "", "a", "ab", "abc", "b"};
+    for (int i = 0; i < 5000; i++) {
+      // a small alphabet and shared prefixes make deep buckets
+      std::string word = i % 3 == 0 ? "common/prefix/" : "";
+      size_t length = generator() % 12;
+      for (size_t j = 0; j < length; j++) {
+        word += static_cast<char>('a' + generator() % 4);
+      }
+      word += static_cast<char>(generator() % 256);
+      words.push_back(word);
+    }
+    std::vector<std::string> expected = words;
+    std::sort(expected.begin(), expected.end());
+    americanFlagSort(words.begin(), words.end());
+    REQUIRE(words == expected);
+  }
+
+  SECTION("American flag sort handles identical strings") {
+    std::vector<std::string> words(1000, "same");
+    americanFlagSort(words.begin(), words.end());
+    REQUIRE(words == std::vector<std::string>(1000, "same"));
+  }
+}
+
+TEST_CASE("External sorting tests") {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path();
+  const std::filesystem::path input = directory / "TestExternalSort.in";
+  const std::filesystem::path output = directory / "TestExternalSort.out";
+  auto writeRecords = [&input](const std::vector<uint64_t> &records) {
+    std::ofstream stream(input, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char *>(records.data()),
+                 static_cast<std::streamsize>(records.size() * 8));
+  };
+  auto readRecords = [&output]() {
+    std::vector<uint64_t> records(std::filesystem::file_size(output) / 8);
+    std::ifstream stream(output, std::ios::binary);
+    stream.read(reinterpret_cast<char *>(records.data()),
+                static_cast<std::streamsize>(records.size() * 8));
+    return records;
+  };
+  ExternalSortOptions options;
+  options.tempDirectory = directory;
+  options.memoryBudget = 64 * 1024;
+
+  SECTION("Files larger than the budget are merged in several passes") {
+    std::mt19937_64 generator(3);
+    std::vector<uint64_t> records(100000);
+    for (uint64_t &record : records) {
+      record = generator() % 50000;
+    }
+    writeRecords(records);
+    ExternalSortStats stats =
+        externalSort<uint64_t>(input, output, std::less<>(), options);
+    std::sort(records.begin(), records.end());
+    REQUIRE(readRecords() == records);
+    REQUIRE(stats.runCount == 25);
+    REQUIRE(stats.mergePasses == 5);
+    REQUIRE(stats.bytesRead >= 2 * records.size() * 8);
+    REQUIRE(stats.bytesWritten >= 2 * records.size() * 8);
+  }
+
+  SECTION("A wide fan-in merges every run in one pass") {
+    std::vector<uint64_t> records(500000);
+    for (size_t i = 0; i < records.size(); i++) {
+      records[i] = (i * 7919) % records.size();
+    }
+    writeRecords(records);
+    options.memoryBudget = 2 << 20;
+    options.maxFanIn = 8;
+    ExternalSortStats stats =
+        externalSort<uint64_t>(input, output, std::greater<>(), options);
+    std::sort(records.begin(), records.end(), std::greater<>());
+    REQUIRE(readRecords() == records);
+    REQUIRE(stats.runCount == 4);
+    REQUIRE(stats.mergePasses == 1);
+    REQUIRE(stats.bytesRead == 2 * records.size() * 8);
+    REQUIRE(stats.bytesWritten == 2 * records.size() * 8);
+  }
+
+  SECTION("A single full run is still copied to the output") {
+    // exactly one run's worth, the end of input shows only on the next read
+    std::vector<uint64_t> records(4096);
+    for (size_t i = 0; i < records.size(); i++) {
+      records[i] = records.size() - i;
+    }
+    writeRecords(records);
+    ExternalSortStats stats =
+        externalSort<uint64_t>(input, output, std::less<>(), options);
+    std::sort(records.begin(), records.end());
+    REQUIRE(readRecords() == records);
+    REQUIRE(stats.runCount == 1);
+  }
+
+  SECTION("Input that fits in one run is sorted without merging") {
+    std::vector<uint64_t> records = {5, 3, 9, 1};
+    writeRecords(records);
+    ExternalSortStats stats =
+        externalSort<uint64_t>(input, output, std::less<>(), options);
+    REQUIRE(readRecords() == std::vector<uint64_t>{1, 3, 5, 9});
+    REQUIRE(stats.runCount == 1);
+    REQUIRE(stats.mergePasses == 0);
+    REQUIRE(stats.bytesRead == 32);
+    REQUIRE(stats.bytesWritten == 32);
+  }
+
+  SECTION("Empty input gives an empty output") {
+    writeRecords({});
+    ExternalSortStats stats = externalSort<uint64_t>(input, output);
+    REQUIRE(std::filesystem::file_size(output) == 0);
+    REQUIRE(stats.runCount == 0);
+  }
+
+  SECTION("Input that is not a whole number of records is rejected") {
+    std::ofstream(input, std::ios::binary | std::ios::trunc) << "abc";
+    REQUIRE_THROWS_AS(externalSort<uint64_t>(input, output),
+                      std::runtime_error);
+  }
+
+  SECTION("Read errors on the input fail the sort") {
+    // a directory opens like a file, but every read of it fails
+    const std::filesystem::path unreadable = directory / "TestExternalSort.d";
+    std::filesystem::create_directory(unreadable);
+    REQUIRE_THROWS_AS(externalSort<uint64_t>(unreadable, output),
+                      std::runtime_error);
+    std::filesystem::remove(unreadable);
+  }
+
+  std::filesystem::remove(input);
+  std::filesystem::remove(output);
+}
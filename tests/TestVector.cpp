@@ -1,7 +1,77 @@
 #include <catch2/catch_test_macros.hpp>
 #define CATCH_CONFIG_MAIN
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "MallocAllocator.h"
 #include "Vector.h"
 
+namespace {
+struct Tracked {
+  static inline size_t defaultConstructions = 0;
+  static inline size_t copies = 0;
+  static inline size_t moves = 0;
+  static inline size_t alive = 0;
+
+  int value = 0;
+
+  Tracked() {
+    defaultConstructions++;
+    alive++;
+  }
+  Tracked(int value) : value(value) { alive++; }
+  Tracked(const Tracked &other) : value(other.value) {
+    copies++;
+    alive++;
+  }
+  Tracked(Tracked &&other) noexcept : value(other.value) {
+    moves++;
+    alive++;
+  }
+  Tracked &operator=(const Tracked &other) {
+    copies++;
+    value = other.value;
+    return *this;
+  }
+  Tracked &operator=(Tracked &&other) noexcept {
+    moves++;
+    value = other.value;
+    return *this;
+  }
+  ~Tracked() { alive--; }
+
+  static void reset() {
+    defaultConstructions = 0;
+    copies = 0;
+    moves = 0;
+    alive = 0;
+  }
+};
+
+// no move constructor, so relocation copies; throws on the copy that
+// reaches the limit
+struct FailingCopy {
+  static inline int live = 0;
+  static inline int copiesLeft = 0;
+
+  int value = 0;
+
+  FailingCopy(int value) : value(value) { live++; }
+  FailingCopy(const FailingCopy &other) : value(other.value) {
+    if (copiesLeft-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+    live++;
+  }
+  FailingCopy &operator=(const FailingCopy &other) = default;
+  ~FailingCopy() { live--; }
+};
+}  // namespace
+
 TEST_CASE("Vector tests") {
   SECTION("Default constructor initializes an empty vector") {
     Vector<int> vector;
@@ -203,3 +273,408 @@ TEST_CASE("Vector tests") {
     REQUIRE(result == expected);
   }
 }
+
+TEST_CASE("Vector storage tests") {
+  Tracked::reset();
+
+  SECTION("Capacity is reserved without constructing elements") {
+    Vector<Tracked> vector(64);
+    REQUIRE(vector.getCapacity() == 64);
+    REQUIRE(Tracked::defaultConstructions == 0);
+    REQUIRE(Tracked::alive == 0);
+  }
+
+  SECTION("Growth relocates live elements by move and constructs nothing else") {
+    const Tracked value(7);
+    {
+      Vector<Tracked> vector;
+      for (int i = 0; i < 100; ++i) {
+        vector.pushBack(value);
+      }
+      REQUIRE(vector.getSize() == 100);
+      REQUIRE(Tracked::defaultConstructions == 0);
+      REQUIRE(Tracked::copies == 100);
+      REQUIRE(Tracked::moves == 16 + 32 + 64);
+      REQUIRE(Tracked::alive == 101);
+    }
+    REQUIRE(Tracked::alive == 1);
+  }
+
+  SECTION("Pushing back an element of the vector itself survives growth") {
+    Vector<Tracked> vector(1);
+    vector.pushBack(Tracked(3));
+    vector.pushBack(vector[0]);
+    REQUIRE(vector.getSize() == 2);
+    REQUIRE(vector[1].value == 3);
+  }
+
+  SECTION("A copy that throws during growth leaves the vector unchanged") {
+    FailingCopy::live = 0;
+    FailingCopy::copiesLeft = 100;
+    {
+      Vector<FailingCopy> vector(4);
+      for (int i = 0; i < 4; ++i) {
+        vector.emplaceBack(i);
+      }
+      FailingCopy extra(9);
+      REQUIRE(FailingCopy::live == 5);
+
+      FailingCopy::copiesLeft = 2;
+      REQUIRE_THROWS_AS(vector.emplaceBack(4), std::runtime_error);
+      FailingCopy::copiesLeft = 2;
+      REQUIRE_THROWS_AS(vector.pushBack(extra), std::runtime_error);
+      FailingCopy::copiesLeft = 3;
+      REQUIRE_THROWS_AS(vector.append(&extra, &extra + 1),
+                        std::runtime_error);
+      FailingCopy::copiesLeft = 1;
+      REQUIRE_THROWS_AS(vector.reserve(32), std::runtime_error);
+
+      REQUIRE(vector.getSize() == 4);
+      REQUIRE(vector.getCapacity() == 4);
+      for (int i = 0; i < 4; ++i) {
+        REQUIRE(vector[i].value == i);
+      }
+      REQUIRE(FailingCopy::live == 5);
+    }
+    REQUIRE(FailingCopy::live == 0);
+  }
+
+  SECTION("Shrinking and erasing destroy exactly the removed elements") {
+    Vector<Tracked> vector(10, Tracked(1));
+    REQUIRE(Tracked::alive == 10);
+    vector.resize(4);
+    REQUIRE(Tracked::alive == 4);
+    vector.erase(0);
+    REQUIRE(Tracked::alive == 3);
+    REQUIRE(Tracked::defaultConstructions == 0);
+  }
+
+  SECTION("Copies construct only the live elements") {
+    Vector<Tracked> vector(100);
+    vector.pushBack(Tracked(1));
+    vector.pushBack(Tracked(2));
+    Tracked::copies = 0;
+    Vector<Tracked> copy(vector);
+    REQUIRE(copy.getCapacity() == 100);
+    REQUIRE(Tracked::copies == 2);
+    REQUIRE(Tracked::defaultConstructions == 0);
+  }
+
+  SECTION("Moved-from vector can grow again") {
+    Vector<int> vector = {1, 2, 3};
+    Vector<int> other(std::move(vector));
+    vector.pushBack(4);
+    REQUIRE(vector.getSize() == 1);
+    REQUIRE(vector[0] == 4);
+  }
+}
+
+TEST_CASE("Vector insertion tests") {
+  Tracked::reset();
+
+  SECTION("Pushing back an rvalue moves instead of copying") {
+    Vector<Tracked> vector(4);
+    vector.pushBack(Tracked(1));
+    vector.pushBack(Tracked(2));
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::moves == 2);
+    REQUIRE(vector[1].value == 2);
+  }
+
+  SECTION("Emplacing constructs in place without copies or moves") {
+    Vector<Tracked> vector(4);
+    Tracked &emplaced = vector.emplaceBack(5);
+    REQUIRE(emplaced.value == 5);
+    REQUIRE(&emplaced == vector.begin());
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::moves == 0);
+  }
+
+  SECTION("Growth on the move paths never copies") {
+    Vector<Tracked> vector(1);
+    for (int i = 0; i < 50; ++i) {
+      vector.emplaceBack(i);
+      vector.pushBack(Tracked(i));
+    }
+    REQUIRE(vector.getSize() == 100);
+    REQUIRE(Tracked::copies == 0);
+  }
+
+  SECTION("Emplacing strings forwards constructor arguments") {
+    Vector<std::string> vector;
+    vector.emplaceBack(3, 'x');
+    std::string moved = "moved";
+    vector.pushBack(std::move(moved));
+    REQUIRE(vector[0] == "xxx");
+    REQUIRE(vector[1] == "moved");
+  }
+
+  SECTION("Reserving grows capacity without changing size") {
+    Vector<Tracked> vector = {Tracked(1), Tracked(2)};
+    Tracked::reset();
+    vector.reserve(100);
+    REQUIRE(vector.getCapacity() == 100);
+    REQUIRE(vector.getSize() == 2);
+    REQUIRE(Tracked::defaultConstructions == 0);
+    REQUIRE(Tracked::copies == 0);
+    vector.reserve(10);
+    REQUIRE(vector.getCapacity() == 100);
+  }
+
+  SECTION("Shrinking to fit drops spare capacity") {
+    Vector<int> vector(64);
+    vector.pushBack(1);
+    vector.pushBack(2);
+    vector.shrinkToFit();
+    REQUIRE(vector.getCapacity() == 2);
+    REQUIRE(vector[0] == 1);
+    REQUIRE(vector[1] == 2);
+  }
+
+  SECTION("Appending a range grows at most once") {
+    Vector<int> vector(2);
+    int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    vector.append(std::begin(values), std::end(values));
+    REQUIRE(vector.getSize() == 10);
+    REQUIRE(vector.getCapacity() == 10);
+    for (size_t i = 0; i < vector.getSize(); ++i) {
+      REQUIRE(vector[i] == values[i]);
+    }
+  }
+
+  SECTION("Appending a vector to itself") {
+    Vector<int> vector = {1, 2, 3};
+    vector.append(vector.begin(), vector.end());
+    REQUIRE(vector.getSize() == 6);
+    REQUIRE(vector[3] == 1);
+    REQUIRE(vector[5] == 3);
+  }
+
+  SECTION("Appending from an input iterator") {
+    std::istringstream input("4 5 6");
+    Vector<int> vector;
+    vector.append(std::istream_iterator<int>(input),
+                  std::istream_iterator<int>());
+    REQUIRE(vector.getSize() == 3);
+    REQUIRE(vector[2] == 6);
+  }
+}
+
+TEST_CASE("Vector batch erase tests") {
+  Tracked::reset();
+
+  SECTION("Erasing a range shifts the tail once") {
+    Vector<int> vector = {0, 1, 2, 3, 4, 5, 6};
+    vector.eraseRange(2, 5);
+    REQUIRE(vector.getSize() == 4);
+    REQUIRE(vector[0] == 0);
+    REQUIRE(vector[1] == 1);
+    REQUIRE(vector[2] == 5);
+    REQUIRE(vector[3] == 6);
+    vector.eraseRange(1, 1);
+    REQUIRE(vector.getSize() == 4);
+    vector.eraseRange(0, 4);
+    REQUIRE(vector.getSize() == 0);
+  }
+
+  SECTION("Erasing an invalid range throws out_of_range exception") {
+    Vector<int> vector = {0, 1, 2};
+    REQUIRE_THROWS_AS(vector.eraseRange(2, 4), std::out_of_range);
+    REQUIRE_THROWS_AS(vector.eraseRange(2, 1), std::out_of_range);
+  }
+
+  SECTION("Erasing by predicate keeps the order of the rest") {
+    Vector<int> vector;
+    for (int i = 0; i < 20; ++i) {
+      vector.pushBack(i);
+    }
+    size_t erased = vector.eraseIf([](int value) { return value % 3 == 0; });
+    REQUIRE(erased == 7);
+    REQUIRE(vector.getSize() == 13);
+    int previous = -1;
+    for (int value : vector) {
+      REQUIRE(value % 3 != 0);
+      REQUIRE(value > previous);
+      previous = value;
+    }
+  }
+
+  SECTION("Batch erase moves and destroys without copying") {
+    Vector<Tracked> vector(16);
+    for (int i = 0; i < 10; ++i) {
+      vector.emplaceBack(i);
+    }
+    vector.eraseIf([](const Tracked &value) { return value.value % 2 == 1; });
+    vector.eraseRange(0, 2);
+    REQUIRE(vector.getSize() == 3);
+    REQUIRE(vector[0].value == 4);
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::alive == 3);
+  }
+
+  SECTION("Swap erase fills the hole with the last element") {
+    Vector<int> vector = {1, 2, 3, 4};
+    REQUIRE(vector.swapErase(1) == 2);
+    REQUIRE(vector.getSize() == 3);
+    REQUIRE(vector[0] == 1);
+    REQUIRE(vector[1] == 4);
+    REQUIRE(vector[2] == 3);
+    REQUIRE(vector.swapErase(2) == 3);
+    REQUIRE(vector.getSize() == 2);
+    REQUIRE_THROWS_AS(vector.swapErase(2), std::out_of_range);
+  }
+}
+
+TEST_CASE("Vector growth and access tests") {
+  SECTION("One and a half growth") {
+    Vector<int, std::allocator<int>, OneAndHalfGrowth> vector(4);
+    for (int i = 0; i < 5; ++i) {
+      vector.pushBack(i);
+    }
+    REQUIRE(vector.getCapacity() == 6);
+    vector.pushBack(5);
+    vector.pushBack(6);
+    REQUIRE(vector.getCapacity() == 9);
+  }
+
+  SECTION("Page aligned growth rounds large buffers to whole pages") {
+    Vector<int, std::allocator<int>, PageAlignedGrowth> vector(8);
+    for (int i = 0; i < 5000; ++i) {
+      vector.pushBack(i);
+      size_t bytes = vector.getCapacity() * sizeof(int);
+      if (bytes > PageAlignedGrowth::PAGE_SIZE) {
+        CAPTURE(i, bytes);
+        CHECK(bytes % PageAlignedGrowth::PAGE_SIZE == 0);
+      }
+    }
+    REQUIRE(vector[4999] == 4999);
+  }
+
+  SECTION("Realloc growth keeps trivially copyable elements") {
+    Vector<int, MallocAllocator<int>, PageAlignedGrowth> vector(1);
+    for (int i = 0; i < 100000; ++i) {
+      vector.pushBack(i);
+    }
+    vector.pushBack(vector[0]);
+    REQUIRE(vector.getSize() == 100001);
+    for (int i = 0; i < 100000; ++i) {
+      CAPTURE(i);
+      CHECK(vector.unchecked(i) == i);
+    }
+    REQUIRE(vector[100000] == 0);
+    vector.shrinkToFit();
+    REQUIRE(vector.getCapacity() == 100001);
+    REQUIRE(vector[99999] == 99999);
+  }
+
+  SECTION("Malloc allocator rejects sizes that overflow") {
+    MallocAllocator<int64_t> allocator;
+    size_t tooMany = (size_t{1} << 61) + 1;
+    REQUIRE_THROWS_AS(allocator.allocate(tooMany), std::bad_array_new_length);
+    int64_t *block = allocator.allocate(4);
+    REQUIRE_THROWS_AS(allocator.reallocate(block, 4, tooMany),
+                      std::bad_array_new_length);
+    allocator.deallocate(block, 4);
+  }
+
+  SECTION("Checked and unchecked access") {
+    Vector<float> vector = {1.5F, 2.5F};
+    const Vector<float> &constVector = vector;
+    REQUIRE(vector.at(1) == 2.5F);
+    REQUIRE(constVector.at(0) == 1.5F);
+    REQUIRE_THROWS_AS(vector.at(2), std::out_of_range);
+    REQUIRE_THROWS_AS(constVector.at(2), std::out_of_range);
+    vector.unchecked(0) = 3.5F;
+    REQUIRE(constVector.unchecked(0) == 3.5F);
+    REQUIRE(vector.data() == vector.begin());
+    REQUIRE(constVector.data()[1] == 2.5F);
+  }
+}
+
+TEST_CASE("Vector serialization tests") {
+  SECTION("Output stream operator prints nothing for an empty vector") {
+    Vector<int> empty;
+    std::ostringstream oss;
+    oss << empty;
+    REQUIRE(oss.str().empty());
+  }
+
+  SECTION("Binary round trip keeps the elements") {
+    Vector<double> vector;
+    for (int i = 0; i < 1000; i++) {
+      vector.pushBack(i * 0.5);
+    }
+    std::stringstream stream;
+    vector.writeBinary(stream);
+    REQUIRE(stream.str().size() ==
+            sizeof(BinaryHeader) + 1000 * sizeof(double));
+
+    Vector<double> loaded = Vector<double>::readBinary(stream);
+    REQUIRE(loaded.getSize() == 1000);
+    REQUIRE(std::equal(loaded.begin(), loaded.end(), vector.begin()));
+  }
+
+  SECTION("Binary round trip of an empty vector") {
+    Vector<int> empty;
+    std::stringstream stream;
+    empty.writeBinary(stream);
+    Vector<int> loaded = Vector<int>::readBinary(stream);
+    REQUIRE(loaded.getSize() == 0);
+    loaded.pushBack(1);
+    REQUIRE(loaded[0] == 1);
+  }
+
+  SECTION("Corrupt input is rejected") {
+    Vector<int> vector = {1, 2, 3};
+    std::stringstream stream;
+    vector.writeBinary(stream);
+    std::string bytes = stream.str();
+
+    std::stringstream wrongType(bytes);
+    REQUIRE_THROWS_AS(Vector<int64_t>::readBinary(wrongType),
+                      std::runtime_error);
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    REQUIRE_THROWS_AS(Vector<int>::readBinary(truncated), std::runtime_error);
+    bytes[0] = 'X';
+    std::stringstream wrongMagic(bytes);
+    REQUIRE_THROWS_AS(Vector<int>::readBinary(wrongMagic), std::runtime_error);
+  }
+
+  SECTION("Oversized counts are rejected before allocating") {
+    BinaryHeader header = BinaryHeader::describe(sizeof(int64_t), 0);
+    // 2^61 + 1 elements of 8 bytes wrap the byte count around to 8
+    header.count = (uint64_t{1} << 61) + 1;
+    std::string bytes(reinterpret_cast<const char *>(&header), sizeof(header));
+    bytes.append(sizeof(int64_t), '\0');
+    std::stringstream wrapping(bytes);
+    REQUIRE_THROWS_AS(
+        (Vector<int64_t, MallocAllocator<int64_t>>::readBinary(wrapping)),
+        std::runtime_error);
+
+    header.count = 1000;
+    std::string shortPayload(reinterpret_cast<const char *>(&header),
+                             sizeof(header));
+    shortPayload.append(2 * sizeof(int64_t), '\0');
+    std::stringstream truncated(shortPayload);
+    REQUIRE_THROWS_AS(Vector<int64_t>::readBinary(truncated),
+                      std::runtime_error);
+  }
+
+  SECTION("Zero-copy view reads the elements in place") {
+    Vector<int> vector = {4, 5, 6};
+    std::stringstream stream;
+    vector.writeBinary(stream);
+    std::string bytes = stream.str();
+    Vector<uint64_t> buffer(bytes.size() / sizeof(uint64_t) + 1);
+    std::memcpy(buffer.data(), bytes.data(), bytes.size());
+
+    std::span<const int> view = viewBinary<int>(buffer.data(), bytes.size());
+    REQUIRE(view.size() == 3);
+    REQUIRE(view[2] == 6);
+    REQUIRE(reinterpret_cast<const std::byte *>(view.data()) ==
+            reinterpret_cast<const std::byte *>(buffer.data()) +
+                sizeof(BinaryHeader));
+    REQUIRE_THROWS_AS(viewBinary<int>(buffer.data(), bytes.size() - 1),
+                      std::runtime_error);
+  }
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_template_test_macros.hpp>
+#include <cstdint>
+
+#include "VectorOps.h"
+
+TEMPLATE_TEST_CASE("VectorOps tests", "[VectorOps]", int32_t, int64_t, float,
+                   double) {
+  // odd sizes exercise the scalar tails after the vector blocks
+  const size_t sizes[] = {0, 1, 3, 7, 8, 17, 33, 64, 1001};
+  const SimdLevel levels[] = {SimdLevel::SCALAR, SimdLevel::SSE42,
+                              SimdLevel::AVX2};
+  SimdLevel original = VectorOps<TestType>::getLevel();
+
+  // dynamic sections, since Catch enters a plain SECTION only on the first
+  // pass through these loops
+  for (SimdLevel requested : levels) {
+    SimdLevel level = VectorOps<TestType>::setLevel(requested);
+    REQUIRE(level <= requested);
+    for (size_t size : sizes) {
+      Vector<TestType> vector(size);
+      for (size_t i = 0; i < size; ++i) {
+        vector.pushBack(static_cast<TestType>((i * 7) % 13));
+      }
+
+      DYNAMIC_SECTION("Sum, min and max match a scalar loop, level "
+                      << static_cast<int>(level) << ", size " << size) {
+        TestType expectedSum = 0;
+        for (size_t i = 0; i < size; ++i) {
+          expectedSum += vector[i];
+        }
+        REQUIRE(sum(vector) == expectedSum);
+        if (size == 0) {
+          REQUIRE_FALSE(min(vector).has_value());
+          REQUIRE_FALSE(max(vector).has_value());
+        } else {
+          vector[size / 2] = -5;
+          REQUIRE(min(vector) == static_cast<TestType>(-5));
+          vector[size - 1] = 100;
+          REQUIRE(max(vector) == static_cast<TestType>(100));
+        }
+      }
+
+      DYNAMIC_SECTION("Find returns the first match and count all of them, "
+                      << "level " << static_cast<int>(level) << ", size "
+                      << size) {
+        size_t expectedCount = 0;
+        std::optional<size_t> expectedIndex;
+        for (size_t i = 0; i < size; ++i) {
+          if (vector[i] == 6) {
+            expectedCount++;
+            expectedIndex = expectedIndex.value_or(i);
+          }
+        }
+        REQUIRE(find(vector, static_cast<TestType>(6)) == expectedIndex);
+        REQUIRE(count(vector, static_cast<TestType>(6)) == expectedCount);
+        REQUIRE_FALSE(find(vector, static_cast<TestType>(50)).has_value());
+        REQUIRE(count(vector, static_cast<TestType>(50)) == 0);
+      }
+
+      DYNAMIC_SECTION("Fill, add and scale are elementwise, level "
+                      << static_cast<int>(level) << ", size " << size) {
+        Vector<TestType> other(size);
+        for (size_t i = 0; i < size; ++i) {
+          other.pushBack(static_cast<TestType>(i % 5));
+        }
+        add(vector, other);
+        scale(vector, static_cast<TestType>(3));
+        for (size_t i = 0; i < size; ++i) {
+          REQUIRE(vector[i] ==
+                  static_cast<TestType>(3 * (((i * 7) % 13) + (i % 5))));
+        }
+        fill(vector, static_cast<TestType>(2));
+        REQUIRE(count(vector, static_cast<TestType>(2)) == size);
+      }
+    }
+  }
+
+  SECTION("Adding vectors of different size throws") {
+    Vector<TestType> vector = {1, 2};
+    Vector<TestType> other = {1};
+    REQUIRE_THROWS_AS(add(vector, other), std::invalid_argument);
+  }
+
+  VectorOps<TestType>::setLevel(original);
+}